@@ -0,0 +1,493 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Microbenchmarks of the decoding core. The inputs are the example files scaled up, so the numbers are comparable
+ between machines and build options.
+
+   decoder_benchmark inflate <time signal file> [scale]
+     Compresses the samples of the time signal, repeated scale times (default: up to 64 MiB), as zlib and gzip stream
+     and inflates them with every available inflate backend
+
+   decoder_benchmark checksum [MiB]
+     Verifies every checksum variant the CPU supports against a plain 16 bit loop and measures it on a buffer of the
+     given size (default 64 MiB)
+
+   decoder_benchmark format [lines]
+     Formats time signal and trend lines with fprintf and with number_format.h into /dev/null, after checking that both
+     give the same text for the given number of lines (default 1000000)
+
+   decoder_benchmark trend_store [chunks]
+     Ingests the given number of small consecutive, overlapping trend chunks (default 2000) into a temporary trend store
+     in a few sessions, checks the entries read back and that the data file holds each entry about once
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <vector>
+#include "../common/checksum.h"
+#include "../common/decoder.h"
+#include "../common/helper_functions.h"
+#include "../common/number_format.h"
+#include "../common/trend_store.h"
+
+// Every measurement runs at least this long
+static const double min_seconds = 1.0;
+
+// Inputs are scaled up to this size if no scale is given
+static const size_t default_size = 64 << 20;
+
+static double Seconds(std::chrono::steady_clock::time_point Start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+}
+
+// Compresses with the default level, WindowBits 15 gives a zlib and 31 a gzip stream
+static bool Compress(const std::vector<Uint8_t> &rInput, int WindowBits, std::vector<Uint8_t> &rOutput)
+{
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  rOutput.resize(deflateBound(&stream, (uLong) rInput.size()));
+  stream.next_in = (Bytef*) rInput.data();
+  stream.avail_in = (uInt) rInput.size();
+  stream.next_out = rOutput.data();
+  stream.avail_out = (uInt) rOutput.size();
+  int err = deflate(&stream, Z_FINISH);
+  rOutput.resize(stream.total_out);
+  deflateEnd(&stream);
+  return err == Z_STREAM_END;
+}
+
+static int BenchmarkInflate(const char *pFileName, size_t Scale)
+{
+  input_file_t input;
+  ReadInputFile(pFileName, input);
+
+  decode_buffer_t decode_buffer;
+  timesignal_view_t timesignal;
+  decode_result_t result = DecodeTimesignal(input.Span(), decode_buffer, timesignal);
+  if (result != decode_ok)
+  {
+    fprintf(stderr, "Error: %s in file %s\n", DecodeResultAsString(result), pFileName);
+    return -1;
+  }
+
+  size_t sample_bytes = (size_t) timesignal.header.sample_count * timesignal.sample_size;
+  if (Scale == 0)
+  {
+    Scale = sample_bytes > 0 && sample_bytes < default_size ? default_size / sample_bytes : 1;
+  }
+  std::vector<Uint8_t> samples(sample_bytes * Scale);
+  for (size_t i = 0; i < Scale; ++i)
+  {
+    memcpy(samples.data() + i * sample_bytes, timesignal.p_samples, sample_bytes);
+  }
+  fprintf(stdout, "Inflate of %zu samples (%.1f MiB) from %s scaled %zu times\n",
+          (size_t) timesignal.header.sample_count * Scale, samples.size() / 1048576.0, pFileName, Scale);
+
+  const int window_bits[] = { 15, 31 };
+  for (int bits : window_bits)
+  {
+    std::vector<Uint8_t> compressed;
+    if (!Compress(samples, bits, compressed))
+    {
+      fprintf(stderr, "Error: Could not compress the samples\n");
+      return -1;
+    }
+
+    for (int backend = inflate_backend_zlib; backend <= inflate_backend_libdeflate; ++backend)
+    {
+      if (!IsInflateBackendAvailable((inflate_backend_t) backend))
+      {
+        fprintf(stdout, "  %-4s %-10s       not available\n", bits == 31 ? "gzip" : "zlib",
+                InflateBackendAsString((inflate_backend_t) backend));
+        continue;
+      }
+
+      decode_buffer_t buffer;
+      buffer.inflate_backend = (inflate_backend_t) backend;
+      buffer.Reserve(samples.size());
+
+      size_t iterations = 0;
+      auto start = std::chrono::steady_clock::now();
+      do
+      {
+        unsigned long length = (unsigned long) samples.size();
+        if (UncompressData(buffer, buffer.p_data, &length, compressed.data(), (unsigned long) compressed.size(), bits)
+            != Z_OK || length != samples.size())
+        {
+          fprintf(stderr, "Error: Inflate with %s failed\n", InflateBackendAsString((inflate_backend_t) backend));
+          return -1;
+        }
+        ++iterations;
+      }
+      while (Seconds(start) < min_seconds);
+      double seconds = Seconds(start);
+
+      if (memcmp(buffer.p_data, samples.data(), samples.size()) != 0)
+      {
+        fprintf(stderr, "Error: Inflate with %s gives wrong data\n", InflateBackendAsString((inflate_backend_t) backend));
+        return -1;
+      }
+      fprintf(stdout, "  %-4s %-10s %8.1f MB/s uncompressed, %8.1f MB/s compressed\n", bits == 31 ? "gzip" : "zlib",
+              InflateBackendAsString((inflate_backend_t) backend), samples.size() * iterations / seconds / 1e6,
+              compressed.size() * iterations / seconds / 1e6);
+    }
+  }
+  return 0;
+}
+
+// The original word by word loop
+static Uint16_t ReferenceChecksum(const Uint8_t *pData, size_t Length)
+{
+  Uint16_t checksum = 0;
+  for (size_t i = 0; i + 1 < Length; i += 2)
+  {
+    Uint16_t word;
+    memcpy(&word, pData + i, sizeof(word));
+    checksum ^= word;
+  }
+  if (Length % 2)
+  {
+    Uint16_t word = 0;
+    memcpy(&word, pData + Length - 1, 1);
+    checksum ^= word;
+  }
+  return checksum;
+}
+
+static int BenchmarkChecksum(size_t Size)
+{
+  std::vector<Uint8_t> data(Size + 8);
+  Uint32_t random = 12345;
+  for (Uint8_t &r_byte : data)
+  {
+    random = random * 1103515245 + 12345;
+    r_byte = (Uint8_t) (random >> 16);
+  }
+
+  fprintf(stdout, "Checksum of %.1f MiB, fastest variant %s\n", Size / 1048576.0,
+          ChecksumVariantAsString(FastestChecksumVariant()));
+
+  volatile Uint16_t sink = 0;
+  size_t iterations = 0;
+  auto start = std::chrono::steady_clock::now();
+  do
+  {
+    sink = sink ^ ReferenceChecksum(data.data() + (iterations & 1), Size);
+    ++iterations;
+  }
+  while (Seconds(start) < min_seconds);
+  fprintf(stdout, "  %-11s %8.2f GB/s\n", "16 bit loop", Size * iterations / Seconds(start) / 1e9);
+  for (int variant = checksum_scalar; variant <= checksum_avx512; ++variant)
+  {
+    const char *p_name = ChecksumVariantAsString((checksum_variant_t) variant);
+    if (!IsChecksumVariantAvailable((checksum_variant_t) variant))
+    {
+      fprintf(stdout, "  %-11s not available\n", p_name);
+      continue;
+    }
+
+    // Odd start addresses and all tail lengths
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+      for (size_t length = 0; length < 1100 && offset + length <= Size; ++length)
+      {
+        if (CalcChecksumVariant((checksum_variant_t) variant, data.data() + offset, length)
+            != ReferenceChecksum(data.data() + offset, length))
+        {
+          fprintf(stderr, "Error: %s checksum wrong for offset %zu, length %zu\n", p_name, offset, length);
+          return -1;
+        }
+      }
+    }
+
+    iterations = 0;
+    start = std::chrono::steady_clock::now();
+    do
+    {
+      sink = sink ^ CalcChecksumVariant((checksum_variant_t) variant, data.data() + (iterations & 1), Size);
+      ++iterations;
+    }
+    while (Seconds(start) < min_seconds);
+    fprintf(stdout, "  %-11s %8.2f GB/s\n", p_name, Size * iterations / Seconds(start) / 1e9);
+  }
+  return 0;
+}
+
+// One output line of a converter, written with fprintf and built with number_format.h
+struct format_case_t
+{
+  const char *p_name;
+  std::function<void(FILE *pOut, size_t Index)> print;
+  std::function<char*(char *pOut, size_t Index)> format;
+};
+
+static int BenchmarkFormat(size_t NumLines)
+{
+  std::vector<Int16_t> int_values(NumLines);
+  std::vector<Float32_t> float_values(NumLines);
+  Uint32_t random = 12345;
+  for (size_t i = 0; i < NumLines; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    int_values[i] = (Int16_t) (random >> 16);
+    float_values[i] = (Float32_t) ((Int32_t) random) / 3e5f;
+  }
+  const double offset = 3.0;
+  const double scaling_factor = 0.000152587890625;
+
+  std::vector<format_case_t> cases;
+  cases.push_back(format_case_t {"int16 sample",
+    [&](FILE *pOut, size_t Index)
+    {
+      fprintf(pOut, "   \t%4lld ", (long long) Index);
+      fprintf(pOut, " \t%11d%c  %lf ", int_values[Index], '\t', (int_values[Index] - offset) * scaling_factor);
+      fprintf(pOut, "\n");
+    },
+    [&](char *pOut, size_t Index)
+    {
+      char *p = AppendLiteral(pOut, "   \t");
+      p = FormatInt(p, (long long) Index, 4);
+      p = AppendLiteral(p, "  \t");
+      p = FormatInt(p, int_values[Index], 11);
+      *p++ = '\t';
+      p = AppendLiteral(p, "  ");
+      p = FormatFixed(p, (int_values[Index] - offset) * scaling_factor);
+      p = AppendLiteral(p, " \n");
+      return p;
+    }});
+  cases.push_back(format_case_t {"float sample",
+    [&](FILE *pOut, size_t Index)
+    {
+      fprintf(pOut, "   \t%4lld ", (long long) Index);
+      fprintf(pOut, " \t%lf%c  %lf ", float_values[Index], '\t', (float_values[Index] - offset) * scaling_factor);
+      fprintf(pOut, "\n");
+    },
+    [&](char *pOut, size_t Index)
+    {
+      char *p = AppendLiteral(pOut, "   \t");
+      p = FormatInt(p, (long long) Index, 4);
+      p = AppendLiteral(p, "  \t");
+      p = FormatFixed(p, float_values[Index]);
+      *p++ = '\t';
+      p = AppendLiteral(p, "  ");
+      p = FormatFixed(p, (float_values[Index] - offset) * scaling_factor);
+      p = AppendLiteral(p, " \n");
+      return p;
+    }});
+  cases.push_back(format_case_t {"trend entry",
+    [&](FILE *pOut, size_t Index)
+    {
+      fprintf(pOut, "  \t%4d  \t%s  \t%12.6lf          \t%12.6f       \t%12.6f                \t%d             \t%d\n",
+              (int) Index, "2025-01-01 00:00:00.000", float_values[Index], float_values[Index] * 0.5f,
+              float_values[Index] * 0.25f, (int) (Index % 100), (int) (Index % 7));
+    },
+    [&](char *pOut, size_t Index)
+    {
+      char *p = AppendLiteral(pOut, "  \t");
+      p = FormatInt(p, (int) Index, 4);
+      p = AppendLiteral(p, "  \t");
+      p = AppendString(p, "2025-01-01 00:00:00.000");
+      p = AppendLiteral(p, "  \t");
+      p = FormatFixed(p, float_values[Index], 6, 12);
+      p = AppendLiteral(p, "          \t");
+      p = FormatFixed(p, float_values[Index] * 0.5f, 6, 12);
+      p = AppendLiteral(p, "       \t");
+      p = FormatFixed(p, float_values[Index] * 0.25f, 6, 12);
+      p = AppendLiteral(p, "                \t");
+      p = FormatInt(p, (int) (Index % 100));
+      p = AppendLiteral(p, "             \t");
+      p = FormatInt(p, (int) (Index % 7));
+      *p++ = '\n';
+      return p;
+    }});
+
+  FILE *p_null = fopen("/dev/null", "w");
+  if (p_null == NULL)
+  {
+    fprintf(stderr, "Error: Could not open /dev/null\n");
+    return -1;
+  }
+
+  fprintf(stdout, "Formatting %zu lines\n", NumLines);
+  std::vector<char> expected;
+  std::vector<char> line(8 * max_number_length);
+  for (const format_case_t &r_case : cases)
+  {
+    // Same text as fprintf, line by line
+    for (size_t i = 0; i < NumLines; ++i)
+    {
+      char *p_buffer = NULL;
+      size_t buffer_size = 0;
+      FILE *p_memory = open_memstream(&p_buffer, &buffer_size);
+      r_case.print(p_memory, i);
+      fclose(p_memory);
+      size_t length = (size_t) (r_case.format(line.data(), i) - line.data());
+      bool equal = length == buffer_size && memcmp(line.data(), p_buffer, length) == 0;
+      free(p_buffer);
+      if (!equal)
+      {
+        fprintf(stderr, "Error: %s line %zu differs from fprintf\n", r_case.p_name, i);
+        fclose(p_null);
+        return -1;
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NumLines; ++i)
+    {
+      r_case.print(p_null, i);
+    }
+    fflush(p_null);
+    double printf_seconds = Seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NumLines; ++i)
+    {
+      fwrite(line.data(), 1, (size_t) (r_case.format(line.data(), i) - line.data()), p_null);
+    }
+    fflush(p_null);
+    double format_seconds = Seconds(start);
+
+    fprintf(stdout, "  %-13s fprintf %6.2f Mlines/s, number_format %6.2f Mlines/s (%.1fx)\n", r_case.p_name,
+            NumLines / printf_seconds / 1e6, NumLines / format_seconds / 1e6, printf_seconds / format_seconds);
+  }
+  fclose(p_null);
+  return 0;
+}
+
+// Chunk i holds the timestamps 2i, 2i + 1 and 2i + 2, so each chunk repeats the last entry of the one before
+static int BenchmarkTrendStore(size_t NumChunks)
+{
+  const size_t num_sessions = 4;
+  std::filesystem::path store = std::filesystem::temp_directory_path() / "decoder_benchmark_trend_store";
+  std::error_code error;
+  std::filesystem::remove_all(store, error);
+
+  trend_header_t header;
+  memset(&header, 0, sizeof(header));
+  memset(header.uuid_characteristic_value_config, 0x5C, sizeof(uuid_t));
+  std::string message;
+  trend_series_t series;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t session = 0; session < num_sessions; ++session)
+  {
+    if (!series.Open(store.string().c_str(), header.uuid_characteristic_value_config, message))
+    {
+      fprintf(stderr, "Error: %s\n", message.c_str());
+      return -1;
+    }
+    for (size_t i = session * NumChunks / num_sessions; i < (session + 1) * NumChunks / num_sessions; ++i)
+    {
+      trend_entry_t entries[3];
+      memset(entries, 0, sizeof(entries));
+      for (size_t j = 0; j < 3; ++j)
+      {
+        entries[j].timestamp = (timestamp_t) (2 * i + j);
+        entries[j].value = (Float64_t) (2 * i + j);
+      }
+      header.first_timestamp = entries[0].timestamp;
+      header.last_timestamp = entries[2].timestamp;
+      if (!series.Add(header, entries, 3, message))
+      {
+        fprintf(stderr, "Error: %s\n", message.c_str());
+        return -1;
+      }
+    }
+    if (!series.Save(message))
+    {
+      fprintf(stderr, "Error: %s\n", message.c_str());
+      return -1;
+    }
+  }
+  double seconds = Seconds(start);
+
+  std::vector<trend_entry_t> entries;
+  if (!series.Open(store.string().c_str(), header.uuid_characteristic_value_config, message)
+      || !series.Read(INT64_MIN, INT64_MAX, entries, message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return -1;
+  }
+  const size_t num_entries = 2 * NumChunks + 1;
+  bool correct = entries.size() == num_entries && series.IndexHeader().entry_count == num_entries;
+  for (size_t i = 0; correct && i < entries.size(); ++i)
+  {
+    correct = entries[i].timestamp == (timestamp_t) i && entries[i].value == (Float64_t) i;
+  }
+  if (!correct)
+  {
+    fprintf(stderr, "Error: Trend store holds %zu entries instead of %zu 0..%zu\n", entries.size(), num_entries,
+            num_entries - 1);
+    return -1;
+  }
+
+  // Each session may rewrite the last block of the one before once, everything else is written once
+  Uint64_t data_size = std::filesystem::file_size(store / (TrendSeriesName(header.uuid_characteristic_value_config)
+                                                            + ".tsd"), error);
+  Uint64_t entries_size = num_entries * sizeof(trend_entry_t);
+  Uint64_t max_size = entries_size + num_sessions * trend_store_block_entries * sizeof(trend_entry_t);
+  fprintf(stdout, "  %zu chunks in %zu sessions: %.0f chunks/s, data file %llu bytes for %llu bytes of entries"
+          " (%.2fx)\n", NumChunks, num_sessions, NumChunks / seconds, data_size, entries_size, (double) data_size / entries_size);
+  std::filesystem::remove_all(store, error);
+  if (data_size > max_size)
+  {
+    fprintf(stderr, "Error: Data file larger than %llu bytes\n", max_size);
+    return -1;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc >= 3 && strcmp(argv[1], "inflate") == 0)
+  {
+    return BenchmarkInflate(argv[2], argc >= 4 ? (size_t) atol(argv[3]) : 0);
+  }
+
+  if (argc >= 2 && strcmp(argv[1], "checksum") == 0)
+  {
+    size_t size = argc >= 3 ? (size_t) atol(argv[2]) << 20 : default_size;
+    return BenchmarkChecksum(size > 0 ? size : default_size);
+  }
+
+  if (argc >= 2 && strcmp(argv[1], "format") == 0)
+  {
+    size_t num_lines = argc >= 3 ? (size_t) atol(argv[2]) : 0;
+    return BenchmarkFormat(num_lines > 0 ? num_lines : 1000000);
+  }
+
+  if (argc >= 2 && strcmp(argv[1], "trend_store") == 0)
+  {
+    size_t num_chunks = argc >= 3 ? (size_t) atol(argv[2]) : 0;
+    return BenchmarkTrendStore(num_chunks > 0 ? num_chunks : 2000);
+  }
+
+  fprintf(stderr, "Usage: %s inflate <time signal file> [scale]\n", argv[0]);
+  fprintf(stderr, "       %s checksum [MiB]\n", argv[0]);
+  fprintf(stderr, "       %s format [lines]\n", argv[0]);
+  fprintf(stderr, "       %s trend_store [chunks]\n", argv[0]);
+  return -1;
+}
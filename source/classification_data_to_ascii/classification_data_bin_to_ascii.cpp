@@ -17,15 +17,18 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <zlib.h>
 #include <string.h>
+#include <string>
 #include <time.h>
 #include <sys/stat.h>
+#include <vector>
+#include "../common/arrow_writer.h"
+#include "../common/batch.h"
 #include "../common/datatypes.h"
+#include "../common/decoder.h"
 #include "../common/helper_functions.h"
-
-#include "ClassificationData.pb.h"
-#include "TransferMessage.pb.h"
+#include "../common/json_writer.h"
+#include "../common/message_stream.h"
 
 #ifdef _MSC_VER
 #include<winsock.h>
@@ -41,198 +44,44 @@
 #include <arpa/inet.h>
 #endif
 
-Uint16_t CalcChecksum(const void *pData, size_t Length)
-{
-
-  Uint64_t int_length = Length / sizeof(Uint16_t);
-  const Uint16_t *p_int_data = (Uint16_t*) pData;
-
-  Uint16_t checksum = 0;
-  Uint32_t i = 0;
-  for (i = 0; i < int_length; ++i)
-  {
-    checksum ^= p_int_data[i];
-  }
-
-  if (0 != Length % sizeof(Uint16_t))
-  {
-    Uint16_t temp = 0;
-    memcpy(&temp, &p_int_data[int_length], Length % sizeof(Uint16_t));
-    checksum ^= temp;
-  }
+static thread_local output_writer_t *outstream = NULL;
 
-  return (checksum);
-}
-
-int UncompressData(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int windowBits)
+// Output format, chosen with --format=
+enum output_format_t
 {
-  z_stream stream;
-  int err = 0;
-
-  stream.next_in = (Bytef*) source;
-  stream.avail_in = (uInt) sourceLen;
-  /* Check for source > 64K on 16-bit machine: */
-  if ((uLong) stream.avail_in != sourceLen) return Z_BUF_ERROR;
-
-  stream.next_out = dest;
-  stream.avail_out = (uInt) *destLen;
-  if ((uLong) stream.avail_out != *destLen) return Z_BUF_ERROR;
-
-  stream.zalloc = (alloc_func) 0;
-  stream.zfree = (free_func) 0;
-
-  err = inflateInit2(&stream, windowBits);
-  if (err != Z_OK) return err;
+  output_text,
+  output_arrow,          // Arrow IPC file
+  output_arrow_stream,   // Arrow IPC stream
+  output_jsonl           // JSON Lines, header object followed by one object per matrix row
+};
 
-  err = inflate(&stream, Z_FINISH);
-  if (err != Z_STREAM_END)
-  {
-    (void) inflateEnd(&stream);
-    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) return Z_DATA_ERROR;
-    return err;
-  }
-  *destLen = stream.total_out;
-
-  err = inflateEnd(&stream);
-  return err;
-}
+static output_format_t output_format = output_text;
 
-static FILE *outstream = stdout;
+// Rows per Arrow record batch
+static const size_t arrow_batch_rows = 65536;
 
 #ifndef O_BINARY 
 #define O_BINARY 0
 #endif
 
-int main(int argc, char **argv)
+void PrintClassification(const classification_view_t &rClassification)
 {
-  PrintVersionNumber();
-
-  int buffer_length = CheckCommandLineParameters(argc, argv, "classification data", outstream);
-
-  char* buffer = ReadInputFileIntoBuffer(argv[1], buffer_length);
-
-  ConvertHexToBinIfNeeded(buffer_length, buffer);
-
-  std::string binary_data = "";
-  smartcheck::TransferMessage transfer_message;
-  if (transfer_message.ParseFromArray(buffer, (int) buffer_length) && transfer_message.IsInitialized()
-      && transfer_message.has_classification_data())
+  if (rClassification.envelope == envelope_transfer_message)
   {
     fprintf(outstream, "Classification data is in transfer message protobuf format\n");
-    binary_data = transfer_message.classification_data().binary_data();
-  }
-  else
-  {
-    smartcheck::ClassificationData classification_data;
-    classification_data.ParseFromArray(buffer, (int) buffer_length);
-
-    if (classification_data.ParseFromArray(buffer, (int) buffer_length) && classification_data.IsInitialized() && !classification_data.classification_data_uuid().empty())
-    {
-      fprintf(outstream, "Classification data is in ProtoBuf format\n");
-      binary_data = classification_data.binary_data();
-    }
-    else
-    {
-      binary_data = std::string(buffer, (int) buffer_length);
-    }
-  }
-  classification_header_t header;
-
-  Uint16_t header_version = *(reinterpret_cast<const Uint16_t*>(&binary_data[0]));
-  classification_header_t *p_classification_data_header = nullptr;
-  switch (header_version)
-  {
-    case CLASSIFICATION_DATA_HEADER_VERSION:
-    {
-      memcpy(&header, &(binary_data[0]), sizeof(classification_header_t));
-      break;
-    }
-    case 1:
-    {
-      classification_header_v1_t header_v1;
-      memcpy(&header_v1, &binary_data[0], sizeof(classification_header_v1_t));
-      Uint16_t calculated_checksum_header = CalcChecksum(&header_v1, sizeof(classification_header_v1_t) - 2);
-      if (calculated_checksum_header != header_v1.checksum_header)
-      {
-        fprintf(stderr, "Error: Header checksum not matching in file %s\n", argv[1]);
-        exit(-1);
-      }
-
-      header.version = header_v1.version;
-      header.header_size = header_v1.header_size;
-      memcpy(header.serial_number, header_v1.serial_number, 32);
-      memcpy(header.comment, header_v1.comment, 256);
-      header.compression = header_v1.compression;
-      memcpy(header.uuid_characteristic_value_config, header_v1.uuid_characteristic_value_config, sizeof(uuid_t));
-      memcpy(header.uuid_classification_data, header_v1.uuid_classification_data, sizeof(uuid_t));
-      header.data_type = header_v1.data_type;
-      header.period_type = header_v1.period_type;
-      header.start_timestamp = header_v1.start_timestamp;
-      header.end_timestamp = header_v1.end_timestamp;
-      header.modified_timestamp = header_v1.modified_timestamp;
-      header.close_timestamp = -1;
-      header.dimensions[0] = header_v1.dimensions[0];
-      header.dimensions[1] = header_v1.dimensions[1];
-      header.sample_rate = header_v1.sample_rate;
-      memcpy(header.unused, header_v1.unused, 4);
-      header.sample_count = header_v1.sample_count;
-      header.byte_count = header_v1.byte_count;
-      header.checksum_data = header_v1.checksum_data;
-      header.checksum_header = CalcChecksum(&header, sizeof(classification_header_t));
-      break;
-    }
-    default:
-      break;
   }
-
-  Uint16_t calculated_checksum_header = CalcChecksum(&header, sizeof(classification_header_t) - 2);
-  if (calculated_checksum_header != header.checksum_header)
+  else if (rClassification.envelope == envelope_protobuf)
   {
-    fprintf(stderr, "Error: Header checksum not matching in file %s\n", argv[1]);
-    exit(-1);
-  }
-
-  if (binary_data.size() != (header.header_size + header.byte_count))
-  {
-    fprintf(stderr, "Error: Data size mismatch %zu <--> %d in %s\n", binary_data.size(),
-            header.header_size + header.byte_count, argv[1]);
-
-    exit(-1);
-  }
-
-  unsigned char *data = new unsigned char[header.byte_count];
-  memcpy(data, &(binary_data[header.header_size]), header.byte_count);
-
-  Uint16_t calculated_checksum_data = CalcChecksum(data, header.byte_count);
-  if (calculated_checksum_data != header.checksum_data)
-  {
-    fprintf(stderr, "Error: Data checksum not matching in file %s\n", argv[1]);
-    exit(-1);
+    fprintf(outstream, "Classification data is in ProtoBuf format\n");
   }
+  classification_header_t header = rClassification.header;
 
   fprintf(outstream, "Header version:       \t%d\n", header.version);
   fprintf(outstream, "Header size:          \t%d\n", header.header_size);
   fprintf(outstream, "Serial number:        \t%s\n", header.serial_number);
   fprintf(outstream, "Comment:              \t%s\n", header.comment);
 
-  std::string compression_str = "unknown";
-  if (header.compression == no_compression)
-  {
-    compression_str = "no compression";
-  }
-  else if (header.compression == zlib)
-  {
-    compression_str = "zlib";
-  }
-  else if (header.compression == int24)
-  {
-    compression_str = "int24";
-  }
-  else if (header.compression == gzip)
-  {
-    compression_str = "gzip";
-  }
-  fprintf(outstream, "Compression:          \t%s (%d)\n", compression_str.c_str(), header.compression);
+  fprintf(outstream, "Compression:          \t%s (%d)\n", CompressionAsString(header.compression), header.compression);
   fprintf(outstream, "Config-uuid:          \t%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X\n",
           header.uuid_characteristic_value_config[0], header.uuid_characteristic_value_config[1],
           header.uuid_characteristic_value_config[2], header.uuid_characteristic_value_config[3],
@@ -354,36 +203,7 @@ int main(int argc, char **argv)
   fprintf(outstream, "Data checksum:        \t%04X\n", header.checksum_data);
   fprintf(outstream, "Header checksum:      \t%04X\n", header.checksum_header);
 
-  Uint64_t *values = 0;
-
-  if (header.compression != no_compression)
-  {
-    size_t array_size = header.dimensions[0].num_classes;
-    if (header.dimensions[1].num_classes > 0)
-    {
-      array_size = header.dimensions[0].num_classes * header.dimensions[1].num_classes;
-    }
-    unsigned char *uncompressed_data = (unsigned char*) malloc(array_size * sizeof(Uint64_t));
-    unsigned long length = (unsigned long) array_size * (unsigned long) sizeof(Uint64_t);
-    if (UncompressData(uncompressed_data, &length, (unsigned char*) data, header.byte_count,
-                       header.compression == zlib ? 15 : 31) != Z_OK)
-    {
-      fprintf(stderr, "Error: Could not uncompress data from file %s\n", argv[1]);
-      exit(-1);
-
-    }
-    if (length != array_size * sizeof(Uint64_t))
-    {
-      fprintf(stderr, "Error: Uncompressed length does not match expected length in file %s\n", argv[1]);
-      exit(-1);
-
-    }
-    values = (Uint64_t*) uncompressed_data;
-  }
-  else
-  {
-    values = (Uint64_t*) data;
-  }
+  const Uint64_t *values = rClassification.p_values;
 
   if (values)
   {
@@ -415,11 +235,238 @@ int main(int argc, char **argv)
     }
 
   }
-  free(buffer);
-  free(data);
+}
+
+static void AddDimensionMetadata(arrow_writer_t &rWriter, const char *pPrefix,
+                                 const classification_dimension_type_t &rDimension)
+{
+  std::string prefix(pPrefix);
+  rWriter.metadata.Add((prefix + "unit").c_str(),
+                      std::string(rDimension.unit_string, strnlen(rDimension.unit_string, sizeof(rDimension.unit_string))));
+  rWriter.metadata.Add((prefix + "unit_uuid").c_str(), UuidAsString(rDimension.unit_uuid));
+  rWriter.metadata.AddInt((prefix + "num_classes").c_str(), rDimension.num_classes);
+  rWriter.metadata.AddFloat((prefix + "lower_border").c_str(), rDimension.lower_border, 9);
+  rWriter.metadata.AddFloat((prefix + "upper_border").c_str(), rDimension.upper_border, 9);
+}
+
+// Writes the matrix as Arrow table with one row per cell: the class indexes of both dimensions and the counter, in the
+// order of the matrix (dimension 1 fastest), so the counter column is written straight from the matrix. The header goes
+// into the schema metadata.
+void WriteClassificationArrow(const classification_view_t &rClassification)
+{
+  const classification_header_t &header = rClassification.header;
+  arrow_writer_t writer(*outstream, output_format == output_arrow_stream ? arrow_stream : arrow_file);
+  writer.AddField("class_d1", arrow_uint32);
+  writer.AddField("class_d2", arrow_uint32);
+  writer.AddField("count", arrow_uint64);
+
+  writer.metadata.AddInt("header_version", header.version);
+  writer.metadata.Add("serial_number",
+                     std::string(header.serial_number, strnlen(header.serial_number, sizeof(header.serial_number))));
+  writer.metadata.Add("comment", std::string(header.comment, strnlen(header.comment, sizeof(header.comment))));
+  writer.metadata.AddInt("compression", header.compression);
+  writer.metadata.Add("config_uuid", UuidAsString(header.uuid_characteristic_value_config));
+  writer.metadata.Add("classification_uuid", UuidAsString(header.uuid_classification_data));
+  writer.metadata.AddInt("data_type", header.data_type);
+  writer.metadata.AddInt("period_type", header.period_type);
+  writer.metadata.AddInt("start_timestamp", header.start_timestamp);
+  writer.metadata.AddInt("end_timestamp", header.end_timestamp);
+  writer.metadata.AddInt("modified_timestamp", header.modified_timestamp);
+  writer.metadata.AddInt("close_timestamp", header.close_timestamp);
+  AddDimensionMetadata(writer, "d1_", header.dimensions[0]);
+  AddDimensionMetadata(writer, "d2_", header.dimensions[1]);
+  writer.metadata.AddInt("sample_rate", header.sample_rate);
+  writer.metadata.AddInt("sample_count", (Int64_t) header.sample_count);
+  writer.WriteSchema();
+
+  static thread_local std::vector<Uint32_t> class_d1;
+  static thread_local std::vector<Uint32_t> class_d2;
+  class_d1.resize(arrow_batch_rows);
+  class_d2.resize(arrow_batch_rows);
+  const size_t num_classes_d1 = header.dimensions[0].num_classes;
+  const size_t value_count = rClassification.p_values ? rClassification.value_count : 0;
+  for (size_t first = 0; first < value_count; first += arrow_batch_rows)
+  {
+    const size_t count = value_count - first < arrow_batch_rows ? value_count - first : arrow_batch_rows;
+    for (size_t i = 0; i < count; ++i)
+    {
+      class_d1[i] = (Uint32_t) ((first + i) % num_classes_d1);
+      class_d2[i] = (Uint32_t) ((first + i) / num_classes_d1);
+    }
+    const void *const column_data[] = { class_d1.data(), class_d2.data(), rClassification.p_values + first };
+    writer.WriteRecordBatch((Int64_t) count, column_data);
+  }
+  writer.Finish();
+}
+
+static void AddDimensionJson(json_writer_t &rJson, const char *pPrefix, const classification_dimension_type_t &rDimension)
+{
+  char key[32];
+  snprintf(key, sizeof(key), "%sunit", pPrefix);
+  rJson.String(key, rDimension.unit_string, strnlen(rDimension.unit_string, sizeof(rDimension.unit_string)));
+  snprintf(key, sizeof(key), "%sunit_uuid", pPrefix);
+  rJson.Uuid(key, json_uuid_t(rDimension.unit_uuid));
+  snprintf(key, sizeof(key), "%snum_classes", pPrefix);
+  rJson.Uint(key, rDimension.num_classes);
+  snprintf(key, sizeof(key), "%slower_border", pPrefix);
+  rJson.Float(key, rDimension.lower_border);
+  snprintf(key, sizeof(key), "%supper_border", pPrefix);
+  rJson.Float(key, rDimension.upper_border);
+}
+
+// Writes the header as first line and one line per row of the matrix (class of dimension 2) with the counters of all
+// classes of dimension 1. Every line carries the classification uuid.
+void WriteClassificationJsonl(const classification_view_t &rClassification)
+{
+  const classification_header_t &header = rClassification.header;
+  const json_uuid_t classification_uuid(header.uuid_classification_data);
+  json_writer_t json(*outstream);
+
+  json.BeginLine();
+  json.String("record", "classification_header");
+  json.Uuid("classification_uuid", classification_uuid);
+  json.Uuid("config_uuid", json_uuid_t(header.uuid_characteristic_value_config));
+  json.Int("header_version", header.version);
+  json.String("serial_number", header.serial_number, strnlen(header.serial_number, sizeof(header.serial_number)));
+  json.String("comment", header.comment, strnlen(header.comment, sizeof(header.comment)));
+  json.Int("compression", header.compression);
+  json.Int("data_type", header.data_type);
+  json.Int("period_type", header.period_type);
+  json.Int("start_timestamp", header.start_timestamp);
+  json.Int("end_timestamp", header.end_timestamp);
+  json.Int("modified_timestamp", header.modified_timestamp);
+  json.Int("close_timestamp", header.close_timestamp);
+  AddDimensionJson(json, "d1_", header.dimensions[0]);
+  AddDimensionJson(json, "d2_", header.dimensions[1]);
+  json.Uint("sample_rate", header.sample_rate);
+  json.Uint("sample_count", header.sample_count);
+  json.EndLine();
+
+  const size_t num_classes_d1 = header.dimensions[0].num_classes;
+  const size_t value_count = rClassification.p_values ? rClassification.value_count : 0;
+  for (size_t first = 0; num_classes_d1 > 0 && first < value_count; first += num_classes_d1)
+  {
+    json.BeginLine();
+    json.String("record", "matrix_row");
+    json.Uuid("classification_uuid", classification_uuid);
+    json.Uint("class_d2", first / num_classes_d1);
+    json.BeginArray("counts");
+    for (size_t i = first; i < first + num_classes_d1 && i < value_count; ++i)
+    {
+      json.Uint(NULL, rClassification.p_values[i]);
+    }
+    json.EndArray();
+    json.EndLine();
+  }
+}
+
+// Prints the classification as text or writes it in the format chosen with --format=
+void OutputClassification(const classification_view_t &rClassification)
+{
+  if (output_format == output_text)
+  {
+    PrintClassification(rClassification);
+  }
+  else if (output_format == output_jsonl)
+  {
+    WriteClassificationJsonl(rClassification);
+  }
+  else
+  {
+    WriteClassificationArrow(rClassification);
+  }
+}
+
+// Convert function of the batch and stream mode, called from several threads
+static bool ConvertClassification(byte_span_t Input, output_writer_t *pOutstream, std::string &rMessage)
+{
+  // Each thread keeps its own decode buffer
+  static thread_local decode_buffer_t thread_buffer;
+  classification_view_t thread_classification;
+  decode_result_t result = DecodeClassification(Input, thread_buffer, thread_classification);
+  if (result != decode_ok)
+  {
+    rMessage = DecodeResultAsString(result);
+    return false;
+  }
+  outstream = pOutstream;
+  OutputClassification(thread_classification);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  decode_buffer_t decode_buffer;
+  classification_view_t classification;
+
+  const char *p_format = TakeOptionValue(argc, argv, "--format=");
+  if (p_format != NULL)
+  {
+    if (strcmp(p_format, "arrow") == 0)
+    {
+      output_format = output_arrow;
+    }
+    else if (strcmp(p_format, "arrows") == 0)
+    {
+      output_format = output_arrow_stream;
+    }
+    else if (strcmp(p_format, "jsonl") == 0)
+    {
+      output_format = output_jsonl;
+    }
+    else if (strcmp(p_format, "text") != 0)
+    {
+      fprintf(stderr, "Error: Unknown output format %s, use text, arrow, arrows or jsonl\n", p_format);
+      exit(-1);
+    }
+  }
+
+  PrintVersionNumber(IsStreamMode(argc, argv) ? stderr : stdout);
+
+  if (IsStreamMode(argc, argv))
+  {
+    if (output_format != output_text && output_format != output_jsonl)
+    {
+      fprintf(stderr, "Error: --stream writes text or jsonl\n");
+      exit(-1);
+    }
+    return RunStream(argc, argv, transfer_message_classification_data, ConvertClassification);
+  }
+
+  if (IsBatchMode(argc, argv))
+  {
+    const char *p_output_extension = output_format == output_arrow ? ".arrow"
+                                     : output_format == output_arrow_stream ? ".arrows"
+                                     : output_format == output_jsonl ? ".jsonl" : ".txt";
+    return RunBatch(argc, argv, ".sccd", ConvertClassification, p_output_extension);
+  }
+
+  static char output_buffer[default_output_buffer_size];
+  output_writer_t output(output_buffer, sizeof(output_buffer));
+  CheckCommandLineParameters(argc, argv, "classification data", output);
+  if (output_format != output_text && argc != 3)
+  {
+    fprintf(stderr, "Error: %s: --format=%s needs an output file\n", argv[0], p_format);
+    exit(-1);
+  }
+  outstream = &output;
+
+  input_file_t input;
+  ReadInputFile(argv[1], input);
+
+  input.size = ConvertHexToBinIfNeeded(input.size, (char*) input.p_data);
+
+  decode_result_t result = DecodeClassification(input.Span(), decode_buffer, classification);
+  if (result != decode_ok)
+  {
+    fprintf(stderr, "Error: %s in file %s\n", DecodeResultAsString(result), argv[1]);
+    exit(-1);
+  }
+  OutputClassification(classification);
+
+  CloseOutput(output);
   if (argc == 3)
   {
-    fclose(outstream);
     fprintf(stderr, "%s: Success: Classification data written to file %s\n", argv[0], argv[2]);
   }
   exit(0);
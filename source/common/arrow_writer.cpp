@@ -0,0 +1,424 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "arrow_writer.h"
+#include <string.h>
+
+// Ids of the unions and enums of Schema.fbs, Message.fbs and File.fbs that are used here
+enum
+{
+  arrow_metadata_v5 = 4,
+  arrow_header_schema = 1,
+  arrow_header_record_batch = 3,
+  arrow_type_int = 2,
+  arrow_type_floating_point = 3,
+  arrow_type_bool = 6,
+  arrow_type_timestamp = 10,
+  arrow_precision_single = 1,
+  arrow_precision_double = 2,
+  arrow_time_unit_microsecond = 2
+};
+
+static const Uint32_t arrow_continuation = 0xFFFFFFFF;
+static const char arrow_magic[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+
+// FlatBuffers structs FieldNode and Buffer of Message.fbs
+struct arrow_field_node_t
+{
+  Int64_t length;
+  Int64_t null_count;
+};
+
+struct arrow_buffer_t
+{
+  Int64_t offset;
+  Int64_t length;
+};
+
+// Builds a FlatBuffer back to front like the FlatBuffers library does: children are written before their parents, so
+// that all offsets point forward. Positions (ref_t) are counted from the end of the buffer, which does not move while
+// the buffer grows towards its front. Only little endian hosts are supported, as everywhere in the decoder.
+class flatbuffer_builder_t
+{
+public:
+  typedef Uint32_t ref_t;
+
+  ref_t Size() const { return (ref_t) (buffer.size() - head); }
+
+  ref_t String(const std::string &rString)
+  {
+    Align(sizeof(Uint32_t), rString.size() + 1);
+    Pad(1);
+    Push(rString.data(), rString.size());
+    PushScalar((Uint32_t) rString.size());
+    return Size();
+  }
+
+  ref_t RefVector(const std::vector<ref_t> &rRefs)
+  {
+    Align(sizeof(Uint32_t), rRefs.size() * sizeof(Uint32_t));
+    for (size_t i = rRefs.size(); i-- > 0;)
+    {
+      PushRef(rRefs[i]);
+    }
+    PushScalar((Uint32_t) rRefs.size());
+    return Size();
+  }
+
+  // Vector of structs, the structs are given in their little endian memory layout
+  ref_t StructVector(const void *pStructs, size_t StructSize, size_t Count, size_t Alignment)
+  {
+    Align(sizeof(Uint32_t), StructSize * Count);
+    Align(Alignment, StructSize * Count);
+    Push(pStructs, StructSize * Count);
+    PushScalar((Uint32_t) Count);
+    return Size();
+  }
+
+  // Fields are added between StartTable and EndTable, anything they refer to has to be built before StartTable
+  void StartTable()
+  {
+    field_refs.clear();
+    table_start = Size();
+  }
+
+  template<typename T>
+  void AddScalar(size_t Field, T Value)
+  {
+    PushScalar(Value);
+    SetField(Field);
+  }
+
+  void AddRef(size_t Field, ref_t Ref)
+  {
+    PushRef(Ref);
+    SetField(Field);
+  }
+
+  // Writes the vtable in front of the table
+  ref_t EndTable()
+  {
+    PushScalar((Int32_t) 0);
+    const ref_t table = Size();
+    for (size_t i = field_refs.size(); i-- > 0;)
+    {
+      PushScalar((Uint16_t) (field_refs[i] ? table - field_refs[i] : 0));
+    }
+    PushScalar((Uint16_t) (table - table_start));
+    PushScalar((Uint16_t) (sizeof(Uint16_t) * (2 + field_refs.size())));
+    const Int32_t vtable_offset = (Int32_t) (Size() - table);
+    memcpy(&buffer[buffer.size() - table], &vtable_offset, sizeof(vtable_offset));
+    return table;
+  }
+
+  // Writes the offset of the root table. The result starts at Data() and has Size() bytes.
+  void Finish(ref_t Root)
+  {
+    Align(min_alignment, sizeof(Uint32_t));
+    PushRef(Root);
+  }
+
+  const Uint8_t* Data() const { return buffer.data() + head; }
+
+private:
+  void Reserve(size_t Length)
+  {
+    if (head >= Length)
+    {
+      return;
+    }
+    const size_t used = buffer.size() - head;
+    size_t new_size = buffer.size() < 256 ? 256 : buffer.size() * 2;
+    while (new_size - used < Length)
+    {
+      new_size *= 2;
+    }
+    std::vector<Uint8_t> grown(new_size);
+    memcpy(grown.data() + new_size - used, buffer.data() + head, used);
+    buffer.swap(grown);
+    head = new_size - used;
+  }
+
+  void Push(const void *pData, size_t Length)
+  {
+    if (Length == 0)
+    {
+      return;
+    }
+    Reserve(Length);
+    head -= Length;
+    memcpy(&buffer[head], pData, Length);
+  }
+
+  void Pad(size_t Length)
+  {
+    Reserve(Length);
+    head -= Length;
+    memset(&buffer[head], 0, Length);
+  }
+
+  // Pads so that the size is a multiple of Alignment once Additional more bytes are written
+  void Align(size_t Alignment, size_t Additional)
+  {
+    if (Alignment > min_alignment)
+    {
+      min_alignment = Alignment;
+    }
+    Pad((Alignment - (Size() + Additional) % Alignment) % Alignment);
+  }
+
+  template<typename T>
+  void PushScalar(T Value)
+  {
+    Align(sizeof(T), 0);
+    Push(&Value, sizeof(T));
+  }
+
+  // Offsets are relative to their own position
+  void PushRef(ref_t Ref)
+  {
+    Align(sizeof(Uint32_t), 0);
+    PushScalar((Uint32_t) (Size() + sizeof(Uint32_t) - Ref));
+  }
+
+  void SetField(size_t Field)
+  {
+    if (field_refs.size() <= Field)
+    {
+      field_refs.resize(Field + 1, 0);
+    }
+    field_refs[Field] = Size();
+  }
+
+  std::vector<Uint8_t> buffer;
+  size_t head = 0;
+  size_t min_alignment = 1;
+  std::vector<ref_t> field_refs;
+  ref_t table_start = 0;
+};
+
+typedef flatbuffer_builder_t::ref_t ref_t;
+
+// Bytes per value, 0 for the bit packed arrow_bool
+static size_t ValueSize(arrow_type_t Type)
+{
+  switch (Type)
+  {
+    case arrow_int8:
+    case arrow_uint8:
+      return 1;
+    case arrow_int16:
+    case arrow_uint16:
+      return 2;
+    case arrow_int32:
+    case arrow_uint32:
+    case arrow_float32:
+      return 4;
+    case arrow_bool:
+      return 0;
+    default:
+      return 8;
+  }
+}
+
+static size_t PaddedSize(size_t Size)
+{
+  return (Size + 7) & ~(size_t) 7;
+}
+
+// Type table of a field, sets rTypeId to its id in the Type union
+static ref_t BuildType(flatbuffer_builder_t &rBuilder, arrow_type_t Type, Uint8_t &rTypeId)
+{
+  if (Type == arrow_timestamp_us)
+  {
+    ref_t timezone = rBuilder.String("UTC");
+    rBuilder.StartTable();
+    rBuilder.AddScalar(0, (Int16_t) arrow_time_unit_microsecond);
+    rBuilder.AddRef(1, timezone);
+    rTypeId = arrow_type_timestamp;
+    return rBuilder.EndTable();
+  }
+
+  rBuilder.StartTable();
+  switch (Type)
+  {
+    case arrow_float32:
+    case arrow_float64:
+      rBuilder.AddScalar(0, (Int16_t) (Type == arrow_float32 ? arrow_precision_single : arrow_precision_double));
+      rTypeId = arrow_type_floating_point;
+      break;
+    case arrow_bool:
+      rTypeId = arrow_type_bool;
+      break;
+    default:
+      rBuilder.AddScalar(0, (Int32_t) (ValueSize(Type) * 8));
+      rBuilder.AddScalar(1, (Uint8_t) (Type <= arrow_int64));
+      rTypeId = arrow_type_int;
+      break;
+  }
+  return rBuilder.EndTable();
+}
+
+static ref_t BuildSchema(flatbuffer_builder_t &rBuilder, const std::vector<std::string> &rNames,
+                         const std::vector<arrow_type_t> &rTypes,
+                         const std::vector<std::pair<std::string, std::string> > &rMetadata)
+{
+  std::vector<ref_t> fields;
+  const ref_t no_children = rBuilder.RefVector(std::vector<ref_t>());
+  for (size_t i = 0; i < rNames.size(); ++i)
+  {
+    ref_t name = rBuilder.String(rNames[i]);
+    Uint8_t type_id = 0;
+    ref_t type = BuildType(rBuilder, rTypes[i], type_id);
+    rBuilder.StartTable();
+    rBuilder.AddRef(0, name);
+    rBuilder.AddScalar(1, (Uint8_t) 0);   // Not nullable
+    rBuilder.AddScalar(2, type_id);
+    rBuilder.AddRef(3, type);
+    rBuilder.AddRef(5, no_children);
+    fields.push_back(rBuilder.EndTable());
+  }
+  const ref_t field_vector = rBuilder.RefVector(fields);
+
+  std::vector<ref_t> key_values;
+  for (size_t i = 0; i < rMetadata.size(); ++i)
+  {
+    ref_t key = rBuilder.String(rMetadata[i].first);
+    ref_t value = rBuilder.String(rMetadata[i].second);
+    rBuilder.StartTable();
+    rBuilder.AddRef(0, key);
+    rBuilder.AddRef(1, value);
+    key_values.push_back(rBuilder.EndTable());
+  }
+  const ref_t metadata_vector = rBuilder.RefVector(key_values);
+
+  rBuilder.StartTable();
+  rBuilder.AddScalar(0, (Int16_t) 0);   // Little endian
+  rBuilder.AddRef(1, field_vector);
+  rBuilder.AddRef(2, metadata_vector);
+  return rBuilder.EndTable();
+}
+
+static void FinishMessage(flatbuffer_builder_t &rBuilder, Uint8_t HeaderType, ref_t Header, Int64_t BodyLength,
+                          std::vector<Uint8_t> &rMessage)
+{
+  rBuilder.StartTable();
+  rBuilder.AddScalar(3, BodyLength);
+  rBuilder.AddRef(2, Header);
+  rBuilder.AddScalar(0, (Int16_t) arrow_metadata_v5);
+  rBuilder.AddScalar(1, HeaderType);
+  rBuilder.Finish(rBuilder.EndTable());
+  rMessage.assign(rBuilder.Data(), rBuilder.Data() + rBuilder.Size());
+}
+
+void arrow_writer_t::AddField(const char *pName, arrow_type_t Type)
+{
+  field_names.push_back(pName);
+  field_types.push_back(Type);
+}
+
+// Encapsulated message: continuation marker, metadata length, FlatBuffer padded to 8 bytes. The body follows.
+void arrow_writer_t::WriteMessage(Int64_t BodyLength)
+{
+  static const Uint8_t padding[8] = { 0 };
+  const Uint32_t padded_length = (Uint32_t) PaddedSize(message.size());
+  if (format == arrow_file && BodyLength >= 0)
+  {
+    block_t block = { (Int64_t) r_output.BytesWritten(), (Int32_t) (8 + padded_length), 0, BodyLength };
+    record_batches.push_back(block);
+  }
+  r_output.Write(&arrow_continuation, sizeof(arrow_continuation));
+  r_output.Write(&padded_length, sizeof(padded_length));
+  r_output.Write(message.data(), message.size());
+  r_output.Write(padding, padded_length - message.size());
+}
+
+void arrow_writer_t::WriteSchema()
+{
+  if (format == arrow_file)
+  {
+    r_output.Write(arrow_magic, sizeof(arrow_magic));
+  }
+  flatbuffer_builder_t builder;
+  ref_t schema = BuildSchema(builder, field_names, field_types, metadata.entries);
+  FinishMessage(builder, arrow_header_schema, schema, 0, message);
+  WriteMessage(-1);
+}
+
+void arrow_writer_t::WriteRecordBatch(Int64_t NumRows, const void *const *ppColumns)
+{
+  // Every column has an empty validity buffer (no nulls) and its values
+  const size_t num_fields = field_types.size();
+  std::vector<arrow_field_node_t> nodes(num_fields);
+  std::vector<arrow_buffer_t> buffers(2 * num_fields);
+  Int64_t body_length = 0;
+  for (size_t i = 0; i < num_fields; ++i)
+  {
+    size_t value_size = ValueSize(field_types[i]);
+    Int64_t length = value_size ? NumRows * (Int64_t) value_size : (NumRows + 7) / 8;
+    nodes[i].length = NumRows;
+    nodes[i].null_count = 0;
+    buffers[2 * i].offset = body_length;
+    buffers[2 * i].length = 0;
+    buffers[2 * i + 1].offset = body_length;
+    buffers[2 * i + 1].length = length;
+    body_length += (Int64_t) PaddedSize((size_t) length);
+  }
+
+  flatbuffer_builder_t builder;
+  ref_t node_vector = builder.StructVector(nodes.data(), sizeof(arrow_field_node_t), nodes.size(), 8);
+  ref_t buffer_vector = builder.StructVector(buffers.data(), sizeof(arrow_buffer_t), buffers.size(), 8);
+  builder.StartTable();
+  builder.AddScalar(0, NumRows);
+  builder.AddRef(1, node_vector);
+  builder.AddRef(2, buffer_vector);
+  ref_t record_batch = builder.EndTable();
+  FinishMessage(builder, arrow_header_record_batch, record_batch, body_length, message);
+  WriteMessage(body_length);
+
+  static const Uint8_t padding[8] = { 0 };
+  for (size_t i = 0; i < num_fields; ++i)
+  {
+    size_t length = (size_t) buffers[2 * i + 1].length;
+    r_output.Write(ppColumns[i], length);
+    r_output.Write(padding, PaddedSize(length) - length);
+  }
+}
+
+void arrow_writer_t::Finish()
+{
+  const Uint32_t end_of_stream[2] = { arrow_continuation, 0 };
+  r_output.Write(end_of_stream, sizeof(end_of_stream));
+  if (format != arrow_file)
+  {
+    return;
+  }
+
+  flatbuffer_builder_t builder;
+  ref_t schema = BuildSchema(builder, field_names, field_types, metadata.entries);
+  ref_t dictionaries = builder.StructVector(NULL, sizeof(block_t), 0, 8);
+  ref_t blocks = builder.StructVector(record_batches.data(), sizeof(block_t), record_batches.size(), 8);
+  builder.StartTable();
+  builder.AddRef(1, schema);
+  builder.AddRef(2, dictionaries);
+  builder.AddRef(3, blocks);
+  builder.AddScalar(0, (Int16_t) arrow_metadata_v5);
+  builder.Finish(builder.EndTable());
+
+  const Int32_t footer_length = (Int32_t) builder.Size();
+  r_output.Write(builder.Data(), builder.Size());
+  r_output.Write(&footer_length, sizeof(footer_length));
+  r_output.Write(arrow_magic, 6);
+}
@@ -0,0 +1,93 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Minimal writer for the Apache Arrow IPC format (columnar format version 1.0, metadata version V5), so trend and
+ classification data can be memory-mapped by pandas, polars, DuckDB etc. instead of parsing text. It covers what the
+ converters need and nothing more: flat schemas of fixed width columns without nulls, key/value metadata on the schema
+ and any number of record batches. The FlatBuffers metadata is built by hand, so no Arrow or FlatBuffers library is
+ needed.
+
+ The file format ("ARROW1" magic, footer with the batch offsets) is random accessible and can be mapped, the stream
+ format is the same sequence of messages without magic and footer. Column buffers are padded to 8 bytes, which is what
+ the format requires for reading them in place.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "datatypes.h"
+#include "key_value_metadata.h"
+#include "output_writer.h"
+
+enum arrow_type_t
+{
+  arrow_int8,
+  arrow_int16,
+  arrow_int32,
+  arrow_int64,
+  arrow_uint8,
+  arrow_uint16,
+  arrow_uint32,
+  arrow_uint64,
+  arrow_float32,
+  arrow_float64,
+  arrow_bool,           // One bit per value, least significant bit first
+  arrow_timestamp_us    // Int64 microseconds since 01.01.1970 UTC
+};
+
+enum arrow_format_t
+{
+  arrow_file,
+  arrow_stream
+};
+
+struct arrow_writer_t
+{
+  arrow_writer_t(output_writer_t &rOutput, arrow_format_t Format) : r_output(rOutput), format(Format) {}
+
+  // Schema, fields and metadata have to be added before WriteSchema
+  void AddField(const char *pName, arrow_type_t Type);
+  key_value_metadata_t metadata;
+
+  // Writes the magic (file format) and the schema message
+  void WriteSchema();
+  // Writes one record batch. ppColumns holds NumRows values of each field in the order of AddField, (NumRows + 7) / 8
+  // bytes for arrow_bool.
+  void WriteRecordBatch(Int64_t NumRows, const void *const *ppColumns);
+  // Writes the end of stream marker and, for the file format, the footer
+  void Finish();
+
+private:
+  // Block of File.fbs: where a record batch message is in the file
+  struct block_t
+  {
+    Int64_t offset;
+    Int32_t metadata_length;
+    Int32_t padding;
+    Int64_t body_length;
+  };
+
+  // Writes the message built last, BodyLength < 0 for the schema
+  void WriteMessage(Int64_t BodyLength);
+
+  output_writer_t &r_output;
+  arrow_format_t format;
+  std::vector<std::string> field_names;
+  std::vector<arrow_type_t> field_types;
+  std::vector<block_t> record_batches;
+  std::vector<Uint8_t> message;
+};
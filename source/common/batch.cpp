@@ -0,0 +1,568 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "batch.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <set>
+#include <vector>
+#include "helper_functions.h"
+#include "package_reassembly.h"
+#include "thread_pool.h"
+
+namespace fs = std::filesystem;
+
+struct batch_input_t
+{
+  fs::path path;
+  fs::path output_name;   // Relative name of the output file below the output directory, without extension
+  Uint64_t message_offset = 0;  // Message within a packed file (list lines "<path>\t<offset>\t<size>")
+  Uint64_t message_size = 0;    // 0 for the whole file
+};
+
+struct batch_result_t
+{
+  std::string input;   // Only for reassembled messages: uuid and number of packages
+  bool success;
+  std::string output_file;
+  std::string message;
+};
+
+// Scratch memory of one worker thread, reused for all inputs the thread converts
+struct batch_worker_t
+{
+  input_file_t input_file;
+  std::vector<char> output_buffer;
+};
+
+bool IsBatchMode(int argc, char **argv)
+{
+  return argc >= 2 && strcmp(argv[1], "--batch") == 0;
+}
+
+// Matches a file name against a pattern with the wildcards '*' and '?'
+static bool MatchPattern(const char *pPattern, const char *pName)
+{
+  const char *p_star = NULL;
+  const char *p_star_name = NULL;
+  while (*pName)
+  {
+    if (*pPattern == '?' || *pPattern == *pName)
+    {
+      ++pPattern;
+      ++pName;
+    }
+    else if (*pPattern == '*')
+    {
+      p_star = pPattern++;
+      p_star_name = pName;
+    }
+    else if (p_star)
+    {
+      pPattern = p_star + 1;
+      pName = ++p_star_name;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  while (*pPattern == '*')
+  {
+    ++pPattern;
+  }
+  return *pPattern == 0;
+}
+
+// pExtensions holds one or more extensions separated by spaces, e.g. ".sctd .scts"
+static bool HasExtension(const fs::path &rPath, const char *pExtensions)
+{
+  std::string extension = rPath.extension().string();
+  if (extension.empty())
+  {
+    return false;
+  }
+  for (const char *p_found = strstr(pExtensions, extension.c_str()); p_found != NULL;
+       p_found = strstr(p_found + 1, extension.c_str()))
+  {
+    char next = p_found[extension.size()];
+    if ((p_found == pExtensions || p_found[-1] == ' ') && (next == 0 || next == ' '))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void AddInput(const std::string &rArgument, const char *pExtension, std::vector<batch_input_t> &rInputs,
+                     std::string &rError)
+{
+  std::error_code error;
+  fs::path path(rArgument);
+  std::string file_name = path.filename().string();
+
+  if (file_name.find_first_of("*?") != std::string::npos)
+  {
+    fs::path directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+    size_t found = rInputs.size();
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+      if (it->is_regular_file(error) && MatchPattern(file_name.c_str(), it->path().filename().string().c_str()))
+      {
+        rInputs.push_back(batch_input_t { it->path(), fs::path(it->path().filename()).replace_extension() });
+      }
+    }
+    std::sort(rInputs.begin() + found, rInputs.end(), [](const batch_input_t &rA, const batch_input_t &rB)
+    {
+      return rA.path < rB.path;
+    });
+    if (rInputs.size() == found)
+    {
+      rError += "Warning: No files match " + rArgument + "\n";
+    }
+  }
+  else if (fs::is_directory(path, error))
+  {
+    size_t found = rInputs.size();
+    for (fs::recursive_directory_iterator it(path, error), end; !error && it != end; it.increment(error))
+    {
+      if (it->is_regular_file(error) && HasExtension(it->path(), pExtension))
+      {
+        rInputs.push_back(batch_input_t { it->path(), fs::relative(it->path(), path).replace_extension() });
+      }
+    }
+    std::sort(rInputs.begin() + found, rInputs.end(), [](const batch_input_t &rA, const batch_input_t &rB)
+    {
+      return rA.path < rB.path;
+    });
+  }
+  else
+  {
+    rInputs.push_back(batch_input_t { path, fs::path(path.filename()).replace_extension() });
+  }
+}
+
+static bool ReadListFile(const char *pListFile, const char *pExtension, std::vector<batch_input_t> &rInputs,
+                         std::string &rError)
+{
+  FILE *p_list = strcmp(pListFile, "-") == 0 ? stdin : fopen(pListFile, "r");
+  if (p_list == NULL)
+  {
+    rError += std::string("Error: Could not open list file ") + pListFile + "\n";
+    return false;
+  }
+
+  char line[4096];
+  while (fgets(line, sizeof(line), p_list))
+  {
+    size_t length = strlen(line);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+    {
+      line[--length] = 0;
+    }
+    // A packed file and the offset and size of one of its messages, as smartcheck_catalog --query prints them
+    char *p_tab = strchr(line, '\t');
+    unsigned long long offset = 0;
+    unsigned long long size = 0;
+    int end = 0;
+    if (p_tab != NULL && sscanf(p_tab + 1, "%llu\t%llu%n", &offset, &size, &end) == 2 && p_tab[1 + end] == 0
+        && size > 0)
+    {
+      *p_tab = 0;
+      fs::path path(line);
+      fs::path output_name = fs::path(path.filename()).replace_extension();
+      output_name += "_" + std::to_string(offset);
+      rInputs.push_back(batch_input_t { path, output_name, offset, size });
+    }
+    else if (length > 0)
+    {
+      AddInput(line, pExtension, rInputs, rError);
+    }
+  }
+
+  if (p_list != stdin)
+  {
+    fclose(p_list);
+  }
+  return true;
+}
+
+// Inputs from different directories or arguments can have the same output name (e.g. a/trend.sctd and b/trend.sctd
+// given as a and b), and so can a reassembled message and an input. They would write the same file, so the later ones
+// get "_2", "_3", ... appended. rUsedNames holds the names already taken.
+static fs::path UniqueOutputName(const fs::path &rOutputName, std::set<std::string> &rUsedNames)
+{
+  std::string name = rOutputName.generic_string();
+#ifdef _WIN32
+  // File names differing only in case are the same file
+  std::transform(name.begin(), name.end(), name.begin(), [](char Character) { return (char) tolower(Character); });
+#endif
+  if (rUsedNames.insert(name).second)
+  {
+    return rOutputName;
+  }
+  for (unsigned number = 2;; ++number)
+  {
+    std::string suffix = "_" + std::to_string(number);
+    if (rUsedNames.insert(name + suffix).second)
+    {
+      fs::path output_name = rOutputName;
+      output_name += suffix;
+      return output_name;
+    }
+  }
+}
+
+bool CollectBatchInputs(int argc, char **argv, int FirstArgument, const char *pExtensions,
+                        std::vector<std::string> &rInputFiles)
+{
+  std::vector<batch_input_t> inputs;
+  std::string error;
+  bool success = true;
+  if (argc == FirstArgument + 2 && strcmp(argv[FirstArgument], "--list") == 0)
+  {
+    success = ReadListFile(argv[FirstArgument + 1], pExtensions, inputs, error);
+  }
+  else
+  {
+    for (int i = FirstArgument; i < argc; ++i)
+    {
+      AddInput(argv[i], pExtensions, inputs, error);
+    }
+  }
+  fprintf(stderr, "%s", error.c_str());
+
+  rInputFiles.clear();
+  rInputFiles.reserve(inputs.size());
+  for (const batch_input_t &r_input : inputs)
+  {
+    rInputFiles.push_back(r_input.path.string());
+  }
+  return success;
+}
+
+// Converts Input into the output file rResult.output_file. A failed conversion removes the output file.
+static void ConvertToFile(byte_span_t Input, batch_worker_t &rWorker, const convert_function_t &rConvert,
+                          batch_result_t &rResult)
+{
+  fs::path output_path(rResult.output_file);
+  std::error_code fs_error;
+  if (output_path.has_parent_path())
+  {
+    fs::create_directories(output_path.parent_path(), fs_error);
+  }
+  if (rWorker.output_buffer.empty())
+  {
+    rWorker.output_buffer.resize(default_output_buffer_size);
+  }
+  output_writer_t output(rWorker.output_buffer.data(), rWorker.output_buffer.size());
+  if (!output.Open(rResult.output_file.c_str(), rResult.message))
+  {
+    rResult.success = false;
+    return;
+  }
+
+  rResult.success = rConvert(Input, &output, rResult.message);
+  std::string write_message;
+  if (!output.Close(write_message) && rResult.success)
+  {
+    rResult.success = false;
+    rResult.message = write_message;
+  }
+  if (!rResult.success)
+  {
+    remove(rResult.output_file.c_str());
+  }
+}
+
+// Opens the input and returns its message in rSpan: the whole file, converted from hex if needed, or the part given
+// with the offset. Returns false and sets rMessage on error.
+static bool OpenInput(const batch_input_t &rInput, input_file_t &rInputFile, byte_span_t &rSpan, std::string &rMessage)
+{
+  if (!rInputFile.Open(rInput.path.string().c_str(), rMessage))
+  {
+    return false;
+  }
+  if (rInput.message_size == 0)
+  {
+    rInputFile.size = ConvertHexToBinIfNeeded(rInputFile.size, (char*) rInputFile.p_data);
+    rSpan = rInputFile.Span();
+    return true;
+  }
+  if (rInput.message_offset > rInputFile.size || rInput.message_size > rInputFile.size - rInput.message_offset)
+  {
+    rInputFile.Close();
+    rMessage = "Message at offset " + std::to_string(rInput.message_offset) + " exceeds the file";
+    return false;
+  }
+  rSpan = byte_span_t { rInputFile.p_data + rInput.message_offset, (size_t) rInput.message_size };
+  return true;
+}
+
+// Converts one input, everything allocated is taken from the worker's scratch memory
+static void ConvertInput(const batch_input_t &rInput, const fs::path &rOutputDirectory, const char *pOutputExtension,
+                         batch_worker_t &rWorker, const convert_function_t &rConvert, batch_result_t &rResult)
+{
+  fs::path output_path = rOutputDirectory / rInput.output_name;
+  output_path += pOutputExtension;
+  input_file_t &r_input_file = rWorker.input_file;
+
+  rResult.success = false;
+  rResult.output_file = output_path.string();
+  byte_span_t input;
+  if (!OpenInput(rInput, r_input_file, input, rResult.message))
+  {
+    return;
+  }
+  ConvertToFile(input, rWorker, rConvert, rResult);
+  r_input_file.Close();
+}
+
+// Uuid of a split message as file name
+static std::string PackageUuidAsString(byte_span_t Uuid)
+{
+  if (Uuid.size == sizeof(uuid_t))
+  {
+    return UuidAsString(Uuid.p_data);
+  }
+  std::string text;
+  char digits[3];
+  for (size_t i = 0; i < Uuid.size; ++i)
+  {
+    snprintf(digits, sizeof(digits), "%02X", Uuid.p_data[i]);
+    text += digits;
+  }
+  return text.empty() ? "no-uuid" : text;
+}
+
+// Reads all inputs in order and takes out the packages of split messages. Each message is converted as soon as its
+// last package is read, into a file named after its uuid. Inputs that are not such packages stay in rInputs.
+static void ReassemblePackages(std::vector<batch_input_t> &rInputs, const fs::path &rOutputDirectory,
+                               const char *pOutputExtension, batch_worker_t &rWorker, const convert_function_t &rConvert,
+                               find_package_function_t FindPackage, std::set<std::string> &rUsedNames,
+                               std::vector<batch_result_t> &rResults, size_t &rNumMessages)
+{
+  rNumMessages = 0;
+  package_reassembler_t reassembler;
+  std::vector<batch_input_t> unsplit_inputs;
+  input_file_t &r_input_file = rWorker.input_file;
+  for (const batch_input_t &r_input : rInputs)
+  {
+    std::string input_file = r_input.path.string();
+    std::string message;
+    package_t package;
+    byte_span_t input;
+    if (!OpenInput(r_input, r_input_file, input, message))
+    {
+      // Reported by the conversion
+      unsplit_inputs.push_back(r_input);
+      continue;
+    }
+    if (!FindPackage(input, package) || package.number_of_packages <= 1)
+    {
+      r_input_file.Close();
+      unsplit_inputs.push_back(r_input);
+      continue;
+    }
+
+    std::string uuid = PackageUuidAsString(package.uuid);
+    byte_span_t binary_data;
+    reassembly_result_t result = reassembler.Add(package, binary_data);
+    r_input_file.Close();
+    if (result == reassembly_complete)
+    {
+      ++rNumMessages;
+      batch_result_t message_result;
+      message_result.input = uuid + " (" + std::to_string(package.number_of_packages) + " packages)";
+      fs::path output_path = rOutputDirectory / UniqueOutputName(uuid, rUsedNames);
+      message_result.output_file = (output_path += pOutputExtension).string();
+      ConvertToFile(binary_data, rWorker, rConvert, message_result);
+      rResults.push_back(message_result);
+    }
+    else if (result == reassembly_error)
+    {
+      ++rNumMessages;
+      rResults.push_back(batch_result_t { input_file, false, "",
+                                          "Package " + std::to_string(package.package_number) + " of "
+                                          + std::to_string(package.number_of_packages) + " of " + uuid
+                                          + " does not fit to the others, message dropped" });
+    }
+    else if (result == reassembly_duplicate)
+    {
+      rResults.push_back(batch_result_t { input_file, true, "", "duplicate package ignored" });
+    }
+  }
+
+  reassembler.ForEachPending([&](byte_span_t Uuid, int Received, int NumberOfPackages)
+  {
+    ++rNumMessages;
+    rResults.push_back(batch_result_t { PackageUuidAsString(Uuid), false, "",
+                                        "Only " + std::to_string(Received) + " of " + std::to_string(NumberOfPackages)
+                                        + " packages found" });
+  });
+  if (reassembler.dropped_messages > 0)
+  {
+    rNumMessages += (size_t) reassembler.dropped_messages;
+    rResults.push_back(batch_result_t { "Reassembly", false, "",
+                                        std::to_string(reassembler.dropped_messages)
+                                        + " incomplete messages dropped, more than "
+                                        + std::to_string(default_max_pending_bytes >> 20) + " MiB of packages pending" });
+  }
+  rInputs.swap(unsplit_inputs);
+}
+
+int RunBatch(int argc, char **argv, const char *pExtension, const convert_function_t &rConvert,
+             const char *pOutputExtension, find_package_function_t FindPackage)
+{
+  unsigned num_threads = DefaultNumThreads();
+  int first_input = 3;
+  if (argc >= 5 && strcmp(argv[3], "--jobs") == 0)
+  {
+    num_threads = (unsigned) atoi(argv[4]);
+    first_input = 5;
+  }
+  bool reassemble = false;
+  if (argc > first_input && strcmp(argv[first_input], "--reassemble") == 0 && FindPackage != NULL)
+  {
+    reassemble = true;
+    ++first_input;
+  }
+
+  if (argc <= first_input || num_threads == 0
+      || (strcmp(argv[first_input], "--list") == 0 && argc != first_input + 2))
+  {
+    const char *p_reassemble = FindPackage != NULL ? " [--reassemble]" : "";
+    fprintf(stderr, "Usage: %s --batch <output directory> [--jobs <threads>]%s <input file | directory | pattern> ...\n",
+            argv[0], p_reassemble);
+    fprintf(stderr, "       %s --batch <output directory> [--jobs <threads>]%s --list <file with input paths, - for stdin>\n",
+            argv[0], p_reassemble);
+    return -1;
+  }
+
+  fs::path output_directory(argv[2]);
+  std::vector<batch_input_t> inputs;
+  std::string error;
+  if (strcmp(argv[first_input], "--list") == 0)
+  {
+    if (!ReadListFile(argv[first_input + 1], pExtension, inputs, error))
+    {
+      fprintf(stderr, "%s", error.c_str());
+      return -1;
+    }
+  }
+  else
+  {
+    for (int i = first_input; i < argc; ++i)
+    {
+      AddInput(argv[i], pExtension, inputs, error);
+    }
+  }
+  fprintf(stderr, "%s", error.c_str());
+
+  std::error_code fs_error;
+  fs::create_directories(output_directory, fs_error);
+
+  // The reassembled messages are written first, so the other inputs make way for their names
+  std::set<std::string> used_names;
+  std::vector<batch_worker_t> workers(num_threads);
+  std::vector<batch_result_t> message_results;
+  size_t num_packages = 0;
+  size_t num_messages = 0;
+  if (reassemble)
+  {
+    num_packages = inputs.size();
+    ReassemblePackages(inputs, output_directory, pOutputExtension, workers[0], rConvert, FindPackage, used_names,
+                       message_results, num_messages);
+    num_packages -= inputs.size();
+  }
+  for (batch_input_t &r_input : inputs)
+  {
+    r_input.output_name = UniqueOutputName(r_input.output_name, used_names);
+  }
+
+  // Largest files first, so that no thread starts a big time signal when the others are already done
+  std::vector<std::pair<uintmax_t, size_t> > order(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    uintmax_t file_size = inputs[i].message_size;
+    if (file_size == 0)
+    {
+      file_size = fs::file_size(inputs[i].path, fs_error);
+      file_size = fs_error ? 0 : file_size;
+    }
+    order[i] = std::make_pair(file_size, i);
+  }
+  std::stable_sort(order.begin(), order.end(), [](const std::pair<uintmax_t, size_t> &rA,
+                                                  const std::pair<uintmax_t, size_t> &rB)
+  {
+    return rA.first > rB.first;
+  });
+
+  std::vector<batch_result_t> results(inputs.size());
+  RunWorkStealing(order.size(), num_threads, [&](unsigned Worker, size_t Index)
+  {
+    size_t input = order[Index].second;
+    ConvertInput(inputs[input], output_directory, pOutputExtension, workers[Worker], rConvert, results[input]);
+  });
+
+  // Files are the inputs converted on their own, messages the ones reassembled from packages
+  size_t num_converted = 0;
+  size_t num_failed = 0;
+  size_t num_messages_converted = 0;
+  size_t num_messages_failed = 0;
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    if (results[i].success)
+    {
+      ++num_converted;
+      fprintf(stdout, "OK      %s -> %s\n", inputs[i].path.string().c_str(), results[i].output_file.c_str());
+    }
+    else
+    {
+      ++num_failed;
+      fprintf(stdout, "FAILED  %s: %s\n", inputs[i].path.string().c_str(), results[i].message.c_str());
+    }
+  }
+
+  for (const batch_result_t &r_result : message_results)
+  {
+    if (!r_result.success)
+    {
+      fprintf(stdout, "FAILED  %s: %s\n", r_result.input.c_str(), r_result.message.c_str());
+    }
+    else if (r_result.output_file.empty())
+    {
+      fprintf(stdout, "SKIPPED %s: %s\n", r_result.input.c_str(), r_result.message.c_str());
+    }
+    else
+    {
+      ++num_messages_converted;
+      fprintf(stdout, "OK      %s -> %s\n", r_result.input.c_str(), r_result.output_file.c_str());
+    }
+  }
+  num_messages_failed = num_messages - num_messages_converted;
+
+  fprintf(stdout, "Batch summary: %zu files, %zu converted, %zu failed", inputs.size(), num_converted, num_failed);
+  if (reassemble)
+  {
+    fprintf(stdout, "; %zu messages from %zu packages, %zu converted, %zu failed", num_messages, num_packages,
+            num_messages_converted, num_messages_failed);
+  }
+  fprintf(stdout, "\n");
+  return num_failed == 0 && num_messages_failed == 0 ? 0 : -1;
+}
@@ -0,0 +1,64 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Batch mode shared by all converters: converts many input files in one process and writes one output file per input.
+
+   <converter> --batch <output directory> [--jobs <threads>] <input file | directory | pattern> ...
+   <converter> --batch <output directory> [--jobs <threads>] --list <file with one input path per line, - for stdin>
+
+ Directories are walked recursively and only files with the converter's extension (e.g. ".sctd") are taken. Patterns may
+ use '*' and '?' in the file name part, e.g. "archive/2025-*.scts". The output file name is the input path relative to
+ the given directory (or the plain file name) with the extension replaced by ".txt" (or the extension of the chosen
+ output format). If inputs end up with the same output name, the later ones get "_2", "_3", ... appended; messages
+ reassembled with --reassemble keep their uuid as name and the other inputs make way.
+ A line of a list file may also name one message of a packed file (length delimited messages, see --stream) as
+ "<path>\t<offset>\t<size>", as smartcheck_catalog --query prints it. Only that message is converted, the
+ output file is named after the file and the offset.
+ The inputs are converted in parallel (default: one thread per hardware thread) with work stealing, largest files
+ first. The convert function is therefore called concurrently and has to keep its state per thread.
+
+ Converters that pass a find package function accept --reassemble after the output directory (and --jobs). All inputs
+ are then read in the given order first; the packages of split messages are reassembled (see package_reassembly.h) and
+ each complete message is converted into a file named after its uuid. The other inputs are converted as usual.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "decoder.h"
+#include "output_writer.h"
+
+// Converts one input into text written to pOutstream. Returns false and sets rMessage if the input can not be converted.
+// Called from several threads at the same time.
+typedef std::function<bool(byte_span_t Input, output_writer_t *pOutstream, std::string &rMessage)> convert_function_t;
+
+// Reads the package fields of an input, FindTrendPackage or FindTimesignalPackage
+typedef bool (*find_package_function_t)(byte_span_t Input, package_t &rPackage);
+
+bool IsBatchMode(int argc, char **argv);
+
+// Runs the batch conversion and prints a result line per file and a summary to stdout. Returns the process exit code.
+// The output files get pOutputExtension instead of the extension of the input. FindPackage enables --reassemble.
+int RunBatch(int argc, char **argv, const char *pExtension, const convert_function_t &rConvert,
+             const char *pOutputExtension = ".txt", find_package_function_t FindPackage = NULL);
+
+// Collects input files like the batch mode for other tools: the arguments from FirstArgument on are files, directories
+// (walked recursively for files with one of the extensions in pExtensions, separated by spaces, e.g. ".sctd .scts") and
+// patterns, or --list and a list file. Warnings go to stderr. Returns false if the list file can not be read.
+bool CollectBatchInputs(int argc, char **argv, int FirstArgument, const char *pExtensions,
+                        std::vector<std::string> &rInputFiles);
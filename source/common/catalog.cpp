@@ -0,0 +1,436 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "catalog.h"
+#include <string.h>
+#include <algorithm>
+#include "output_writer.h"
+
+const char* CatalogKindAsString(catalog_kind8_t Kind)
+{
+  switch (Kind)
+  {
+    case catalog_trend:
+      return "trend";
+    case catalog_timesignal:
+      return "timesignal";
+    case catalog_classification:
+      return "classification";
+    default:
+      return "unknown";
+  }
+}
+
+catalog_kind8_t CatalogKindFromExtension(const char *pFileName)
+{
+  const char *p_extension = strrchr(pFileName, '.');
+  if (p_extension == NULL)
+  {
+    return (catalog_kind8_t) 0;
+  }
+  if (strcmp(p_extension, ".sctd") == 0)
+  {
+    return catalog_trend;
+  }
+  if (strcmp(p_extension, ".scts") == 0)
+  {
+    return catalog_timesignal;
+  }
+  if (strcmp(p_extension, ".sccd") == 0)
+  {
+    return catalog_classification;
+  }
+  return (catalog_kind8_t) 0;
+}
+
+bool ReadCatalogRecord(byte_span_t Input, catalog_kind8_t DefaultKind, catalog_record_t &rRecord,
+                       std::string &rMessage)
+{
+  memset(&rRecord, 0, sizeof(rRecord));
+  catalog_kind8_t kind = DefaultKind;
+  input_kind_t input_kind = PeekInputKind(Input);
+  if (input_kind.envelope == envelope_transfer_message)
+  {
+    kind = input_kind.transfer_message_field == transfer_message_trend ? catalog_trend
+           : input_kind.transfer_message_field == transfer_message_timesignal ? catalog_timesignal
+           : input_kind.transfer_message_field == transfer_message_classification_data ? catalog_classification
+           : (catalog_kind8_t) 0;
+  }
+
+  package_t package;
+  if ((kind == catalog_trend && FindTrendPackage(Input, package))
+      || (kind == catalog_timesignal && FindTimesignalPackage(Input, package)))
+  {
+    if (package.number_of_packages > 1)
+    {
+      rMessage = "Package " + std::to_string(package.package_number) + " of "
+                 + std::to_string(package.number_of_packages) + " of a split message, reassemble it first";
+      return false;
+    }
+  }
+
+  decode_result_t result = decode_ok;
+  switch (kind)
+  {
+    case catalog_trend:
+    {
+      trend_view_t trend;
+      result = DecodeTrendHeaderOnly(Input, trend);
+      const trend_header_t &header = trend.header;
+      rRecord.envelope = (Uint8_t) trend.envelope;
+      rRecord.header_version = header.version;
+      memcpy(rRecord.uuid_config, header.uuid_characteristic_value_config, sizeof(uuid_t));
+      memcpy(rRecord.uuid_message, header.uuid_trend, sizeof(uuid_t));
+      rRecord.first_timestamp = header.first_timestamp;
+      rRecord.last_timestamp = header.last_timestamp;
+      rRecord.sample_count = (Uint64_t) header.value_count;
+      rRecord.byte_count = (Uint32_t) header.byte_count;
+      rRecord.compression = (Uint32_t) header.compression;
+      break;
+    }
+    case catalog_timesignal:
+    {
+      timesignal_view_t timesignal;
+      result = DecodeTimesignalHeaderOnly(Input, timesignal);
+      const timesignal_header_t &header = timesignal.header;
+      rRecord.envelope = (Uint8_t) timesignal.envelope;
+      rRecord.header_version = header.version;
+      rRecord.type = (Uint32_t) header.signal_type;
+      memcpy(rRecord.uuid_config, header.uuid_config, sizeof(uuid_t));
+      memcpy(rRecord.uuid_message, header.uuid_measurement, sizeof(uuid_t));
+      rRecord.first_timestamp = header.timestamp_microseconds;
+      rRecord.last_timestamp = header.timestamp_microseconds;
+      rRecord.sample_count = header.sample_count;
+      rRecord.byte_count = header.byte_count;
+      rRecord.compression = (Uint32_t) header.compression;
+      rRecord.sample_type = (Uint32_t) header.sample_type;
+      break;
+    }
+    case catalog_classification:
+    {
+      classification_view_t classification;
+      result = DecodeClassificationHeaderOnly(Input, classification);
+      const classification_header_t &header = classification.header;
+      rRecord.envelope = (Uint8_t) classification.envelope;
+      rRecord.header_version = header.version;
+      rRecord.type = (Uint32_t) header.data_type;
+      memcpy(rRecord.uuid_config, header.uuid_characteristic_value_config, sizeof(uuid_t));
+      memcpy(rRecord.uuid_message, header.uuid_classification_data, sizeof(uuid_t));
+      rRecord.first_timestamp = header.start_timestamp;
+      rRecord.last_timestamp = header.end_timestamp;
+      rRecord.sample_count = header.sample_count;
+      rRecord.byte_count = header.byte_count;
+      rRecord.compression = (Uint32_t) header.compression;
+      break;
+    }
+    default:
+      rMessage = input_kind.envelope == envelope_transfer_message
+                 ? "TransferMessage without trend, time signal or classification data"
+                 : "Unknown kind of message, the file extension is none of .sctd, .scts and .sccd";
+      return false;
+  }
+  rRecord.kind = (Uint8_t) kind;
+  if (result != decode_ok)
+  {
+    rMessage = DecodeResultAsString(result);
+    return false;
+  }
+  return true;
+}
+
+static Uint64_t UuidHash(const uuid_t Uuid)
+{
+  Uint64_t low;
+  Uint64_t high;
+  memcpy(&low, Uuid, sizeof(low));
+  memcpy(&high, Uuid + sizeof(low), sizeof(high));
+  Uint64_t hash = (low ^ high) * 0x9E3779B97F4A7C15ull;
+  return hash ^ (hash >> 32);
+}
+
+static const Uint8_t* RecordUuid(const catalog_record_t &rRecord, bool Message)
+{
+  return Message ? rRecord.uuid_message : rRecord.uuid_config;
+}
+
+// Appends the uuid index of uuid_message or uuid_config to rIndex, padded to a multiple of 8 bytes
+static void BuildUuidIndex(const std::vector<catalog_record_t> &rRecords, bool Message, std::vector<Uint8_t> &rIndex)
+{
+  // The records are in time order, so the stable sort keeps each group in time order as well
+  std::vector<Uint32_t> order(rRecords.size());
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    order[i] = (Uint32_t) i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](Uint32_t A, Uint32_t B)
+  {
+    return memcmp(RecordUuid(rRecords[A], Message), RecordUuid(rRecords[B], Message), sizeof(uuid_t)) < 0;
+  });
+
+  size_t num_uuids = 0;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (i == 0 || memcmp(RecordUuid(rRecords[order[i]], Message), RecordUuid(rRecords[order[i - 1]], Message),
+                         sizeof(uuid_t)) != 0)
+    {
+      ++num_uuids;
+    }
+  }
+  // At most half of the slots are used, so a lookup takes one or two probes
+  Uint64_t slot_count = 2;
+  while (slot_count < 2 * num_uuids)
+  {
+    slot_count *= 2;
+  }
+  std::vector<catalog_uuid_slot_t> slots(slot_count);
+  memset(slots.data(), 0, slots.size() * sizeof(catalog_uuid_slot_t));
+  for (size_t first = 0; first < order.size();)
+  {
+    const Uint8_t *p_uuid = RecordUuid(rRecords[order[first]], Message);
+    size_t end = first + 1;
+    while (end < order.size() && memcmp(RecordUuid(rRecords[order[end]], Message), p_uuid, sizeof(uuid_t)) == 0)
+    {
+      ++end;
+    }
+    Uint64_t slot = UuidHash(p_uuid) & (slot_count - 1);
+    while (slots[slot].count != 0)
+    {
+      slot = (slot + 1) & (slot_count - 1);
+    }
+    memcpy(slots[slot].uuid, p_uuid, sizeof(uuid_t));
+    slots[slot].first = (Uint32_t) first;
+    slots[slot].count = (Uint32_t) (end - first);
+    first = end;
+  }
+
+  size_t offset = rIndex.size();
+  size_t size = sizeof(slot_count) + slots.size() * sizeof(catalog_uuid_slot_t) + order.size() * sizeof(Uint32_t);
+  rIndex.resize(offset + ((size + 7) & ~(size_t) 7));
+  memcpy(&rIndex[offset], &slot_count, sizeof(slot_count));
+  offset += sizeof(slot_count);
+  memcpy(&rIndex[offset], slots.data(), slots.size() * sizeof(catalog_uuid_slot_t));
+  offset += slots.size() * sizeof(catalog_uuid_slot_t);
+  if (!order.empty())
+  {
+    memcpy(&rIndex[offset], order.data(), order.size() * sizeof(Uint32_t));
+  }
+}
+
+bool WriteCatalog(const char *pFileName, std::vector<catalog_record_t> &rRecords, const std::string &rPaths,
+                  std::string &rMessage)
+{
+  if (rRecords.size() > UINT32_MAX)
+  {
+    rMessage = "More than 4294967295 messages";
+    return false;
+  }
+  std::stable_sort(rRecords.begin(), rRecords.end(), [](const catalog_record_t &rA, const catalog_record_t &rB)
+  {
+    return rA.first_timestamp < rB.first_timestamp;
+  });
+
+  catalog_file_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, catalog_magic, sizeof(header.magic));
+  header.version = catalog_version;
+  header.record_size = sizeof(catalog_record_t);
+  header.record_count = rRecords.size();
+  header.records_offset = sizeof(header);
+  for (const catalog_record_t &r_record : rRecords)
+  {
+    if (r_record.last_timestamp - r_record.first_timestamp > header.max_time_span)
+    {
+      header.max_time_span = r_record.last_timestamp - r_record.first_timestamp;
+    }
+  }
+
+  std::vector<Uint8_t> indexes;
+  header.config_index_offset = header.records_offset + rRecords.size() * sizeof(catalog_record_t);
+  BuildUuidIndex(rRecords, false, indexes);
+  header.message_index_offset = header.config_index_offset + indexes.size();
+  BuildUuidIndex(rRecords, true, indexes);
+  header.paths_offset = header.config_index_offset + indexes.size();
+  header.paths_size = rPaths.size();
+
+  // Records, indexes and paths are large and go to the file directly, the buffer only collects the file header
+  char buffer[sizeof(header)];
+  output_writer_t output(buffer, sizeof(buffer));
+  if (!output.Open(pFileName, rMessage))
+  {
+    return false;
+  }
+  output.Preallocate(header.paths_offset + header.paths_size);
+  output.Write(&header, sizeof(header));
+  if (!rRecords.empty())
+  {
+    output.Write(rRecords.data(), rRecords.size() * sizeof(catalog_record_t));
+  }
+  output.Write(indexes.data(), indexes.size());
+  output.Write(rPaths.data(), rPaths.size());
+  return output.Close(rMessage);
+}
+
+bool catalog_t::CheckIndex(Uint64_t Offset, std::string &rMessage) const
+{
+  Uint64_t slot_count = 0;
+  if (Offset % 8 != 0 || Offset > file.size || file.size - Offset < sizeof(slot_count))
+  {
+    rMessage = "Index out of range";
+    return false;
+  }
+  memcpy(&slot_count, file.p_data + Offset, sizeof(slot_count));
+  if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0
+      || slot_count > (file.size - Offset - sizeof(slot_count)) / sizeof(catalog_uuid_slot_t)
+      || p_header->record_count * sizeof(Uint32_t)
+         > file.size - Offset - sizeof(slot_count) - slot_count * sizeof(catalog_uuid_slot_t))
+  {
+    rMessage = "Index out of range";
+    return false;
+  }
+  return true;
+}
+
+bool catalog_t::Open(const char *pFileName, std::string &rMessage)
+{
+  p_header = nullptr;
+  if (!file.Open(pFileName, rMessage, false))
+  {
+    return false;
+  }
+  const catalog_file_header_t *p_header_read = (const catalog_file_header_t*) file.p_data;
+  if (file.size < sizeof(catalog_file_header_t) || memcmp(p_header_read->magic, catalog_magic, sizeof(catalog_magic)) != 0)
+  {
+    rMessage = "Not a catalog file";
+    return false;
+  }
+  if (p_header_read->version != catalog_version || p_header_read->record_size != sizeof(catalog_record_t))
+  {
+    rMessage = "Catalog version " + std::to_string(p_header_read->version) + " is not supported, create it again";
+    return false;
+  }
+  if (p_header_read->records_offset % 8 != 0 || p_header_read->records_offset > file.size
+      || p_header_read->record_count > (file.size - p_header_read->records_offset) / sizeof(catalog_record_t)
+      || p_header_read->paths_offset > file.size || p_header_read->paths_size > file.size - p_header_read->paths_offset)
+  {
+    rMessage = "Catalog file is truncated";
+    return false;
+  }
+  p_header = p_header_read;
+  if (!CheckIndex(p_header->config_index_offset, rMessage) || !CheckIndex(p_header->message_index_offset, rMessage))
+  {
+    p_header = nullptr;
+    return false;
+  }
+  p_records = (const catalog_record_t*) (file.p_data + p_header->records_offset);
+  p_paths = (const char*) file.p_data + p_header->paths_offset;
+  return true;
+}
+
+std::string catalog_t::Path(const catalog_record_t &rRecord) const
+{
+  if (rRecord.path_offset > p_header->paths_size || rRecord.path_length > p_header->paths_size - rRecord.path_offset)
+  {
+    return std::string();
+  }
+  return std::string(p_paths + rRecord.path_offset, rRecord.path_length);
+}
+
+static bool Matches(const catalog_record_t &rRecord, const catalog_query_t &rQuery)
+{
+  return rRecord.first_timestamp <= rQuery.to && rRecord.last_timestamp >= rQuery.from
+         && (!rQuery.has_uuid_config || memcmp(rRecord.uuid_config, rQuery.uuid_config, sizeof(uuid_t)) == 0)
+         && (!rQuery.has_uuid_message || memcmp(rRecord.uuid_message, rQuery.uuid_message, sizeof(uuid_t)) == 0)
+         && (rQuery.kind == 0 || rRecord.kind == rQuery.kind)
+         && (!rQuery.has_type || rRecord.type == rQuery.type);
+}
+
+// Records can only overlap from..to if they start from - max_time_span or later
+static timestamp_t EarliestFirstTimestamp(const catalog_query_t &rQuery, Int64_t MaxTimeSpan)
+{
+  return rQuery.from < INT64_MIN + MaxTimeSpan ? INT64_MIN : rQuery.from - MaxTimeSpan;
+}
+
+void catalog_t::QueryIndex(Uint64_t IndexOffset, const uuid_t Uuid, const catalog_query_t &rQuery,
+                           const catalog_found_function_t &Found) const
+{
+  Uint64_t slot_count;
+  memcpy(&slot_count, file.p_data + IndexOffset, sizeof(slot_count));
+  const catalog_uuid_slot_t *p_slots = (const catalog_uuid_slot_t*) (file.p_data + IndexOffset + sizeof(slot_count));
+  const Uint32_t *p_order = (const Uint32_t*) (p_slots + slot_count);
+  const Uint64_t record_count = p_header->record_count;
+
+  Uint64_t slot = UuidHash(Uuid) & (slot_count - 1);
+  for (Uint64_t probes = 0; probes < slot_count && p_slots[slot].count != 0; ++probes)
+  {
+    const catalog_uuid_slot_t &r_slot = p_slots[slot];
+    if (memcmp(r_slot.uuid, Uuid, sizeof(uuid_t)) != 0)
+    {
+      slot = (slot + 1) & (slot_count - 1);
+      continue;
+    }
+    if (r_slot.first > record_count || r_slot.count > record_count - r_slot.first)
+    {
+      return;
+    }
+    const Uint32_t *p_begin = p_order + r_slot.first;
+    const Uint32_t *p_end = p_begin + r_slot.count;
+    timestamp_t earliest = EarliestFirstTimestamp(rQuery, p_header->max_time_span);
+    const Uint32_t *p_first = std::lower_bound(p_begin, p_end, earliest, [&](Uint32_t Record, timestamp_t Timestamp)
+    {
+      return Record < record_count && p_records[Record].first_timestamp < Timestamp;
+    });
+    for (const Uint32_t *p = p_first; p < p_end && *p < record_count; ++p)
+    {
+      const catalog_record_t &r_record = p_records[*p];
+      if (r_record.first_timestamp > rQuery.to)
+      {
+        break;
+      }
+      if (Matches(r_record, rQuery))
+      {
+        Found(r_record);
+      }
+    }
+    return;
+  }
+}
+
+void catalog_t::Query(const catalog_query_t &rQuery, const catalog_found_function_t &Found) const
+{
+  if (rQuery.has_uuid_message)
+  {
+    QueryIndex(p_header->message_index_offset, rQuery.uuid_message, rQuery, Found);
+    return;
+  }
+  if (rQuery.has_uuid_config)
+  {
+    QueryIndex(p_header->config_index_offset, rQuery.uuid_config, rQuery, Found);
+    return;
+  }
+
+  const catalog_record_t *p_end = p_records + p_header->record_count;
+  const catalog_record_t *p_first = std::lower_bound(p_records, p_end,
+                                                     EarliestFirstTimestamp(rQuery, p_header->max_time_span),
+                                                     [](const catalog_record_t &rRecord, timestamp_t Timestamp)
+  {
+    return rRecord.first_timestamp < Timestamp;
+  });
+  for (const catalog_record_t *p = p_first; p < p_end && p->first_timestamp <= rQuery.to; ++p)
+  {
+    if (Matches(*p, rQuery))
+    {
+      Found(*p);
+    }
+  }
+}
@@ -0,0 +1,150 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Catalog of an archive: one fixed size record per message with the uuids, timestamps, type, sample count and
+ compression from its header, so questions like "which time signals exist for config X between A and B" do not need
+ the messages to be converted. The records are filled from the header alone (see DecodeTrendHeaderOnly), the data
+ arrays are neither read nor inflated.
+
+ File layout, all numbers little endian:
+   catalog_file_header_t
+   catalog_record_t[record_count]       at records_offset, sorted by first_timestamp
+   uuid index of uuid_config            at config_index_offset
+   uuid index of uuid_message           at message_index_offset
+   paths                                at paths_offset, the file paths of the records one after the other, no separator
+
+ A uuid index is a hash table with open addressing: Uint64_t slot_count (a power of 2), catalog_uuid_slot_t
+ slots[slot_count] and Uint32_t order[record_count]. The slot of a uuid holds where its records start in order and
+ how many there are; order lists the record numbers grouped by uuid and within a group by first_timestamp. A lookup is
+ one probe plus a binary search for the time range, so the catalog is only mapped, never read as a whole.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "datatypes.h"
+#include "decoder.h"
+#include "input_file.h"
+
+const char catalog_magic[8] = { 'S', 'C', 'C', 'A', 'T', 'L', 'G', 0 };
+const Uint32_t catalog_version = 2;
+
+enum catalog_kind8_t
+{
+  catalog_trend = 1,
+  catalog_timesignal = 2,
+  catalog_classification = 3
+};
+
+struct catalog_file_header_t
+{ // Size: 80 byte
+  char magic[8];                // catalog_magic
+  Uint32_t version;             // catalog_version
+  Uint32_t record_size;         // sizeof(catalog_record_t)
+  Uint64_t record_count;
+  Uint64_t records_offset;
+  Uint64_t paths_offset;
+  Uint64_t paths_size;
+  Int64_t max_time_span;        // Largest last_timestamp - first_timestamp of the records
+  Uint64_t config_index_offset;
+  Uint64_t message_index_offset;
+};
+
+struct catalog_uuid_slot_t
+{ // Size: 24 byte
+  uuid_t uuid;
+  Uint32_t first;               // Position of the first record of the uuid in order
+  Uint32_t count;               // Number of records, 0 for an empty slot
+};
+
+struct catalog_record_t
+{ // Size: 112 byte
+  Uint8_t kind;                 // catalog_kind8_t
+  Uint8_t envelope;             // envelope_t
+  Uint16_t header_version;
+  Uint32_t type;                // Time signal: signal_type, classification: data_type, trend: 0
+  uuid_t uuid_config;           // Time signal: uuid_config, trend and classification: uuid_characteristic_value_config
+  uuid_t uuid_message;          // uuid_measurement, uuid_trend or uuid_classification_data
+  timestamp_t first_timestamp;  // Time signal: timestamp_microseconds, trend: first_timestamp, classification: start
+  timestamp_t last_timestamp;   // Time signal: timestamp_microseconds, trend: last_timestamp, classification: end
+  Uint64_t sample_count;        // sample_count, value_count of a trend
+  Uint64_t byte_count;          // Size of the data array as stored
+  Uint32_t compression;         // compression32_t
+  Uint32_t sample_type;         // Time signal: sample_datatype32_t, otherwise 0
+  Uint64_t message_offset;      // Position of the message in the file, not 0 only in packed files
+  Uint64_t message_size;
+  Uint64_t path_offset;         // File path in the paths block
+  Uint32_t path_length;
+  Uint32_t unused;
+};
+
+const char* CatalogKindAsString(catalog_kind8_t Kind);
+
+// Kind of the messages in a file named pFileName: .sctd, .scts or .sccd, 0 if none of them
+catalog_kind8_t CatalogKindFromExtension(const char *pFileName);
+
+// Fills rRecord from the header of the message in Input. A TransferMessage tells its kind, bare messages and raw binary
+// data are taken as DefaultKind. The path and offset fields are left to the caller. Returns false and sets rMessage if
+// the header can not be read or the message is one package of a split message (these have to be reassembled first).
+bool ReadCatalogRecord(byte_span_t Input, catalog_kind8_t DefaultKind, catalog_record_t &rRecord,
+                       std::string &rMessage);
+
+// Writes a catalog with the records, their indexes and the paths block they point into. rRecords is sorted by
+// first_timestamp. Returns false and sets rMessage on error.
+bool WriteCatalog(const char *pFileName, std::vector<catalog_record_t> &rRecords, const std::string &rPaths,
+                  std::string &rMessage);
+
+// Records a query asks for. Unset filters match everything.
+struct catalog_query_t
+{
+  bool has_uuid_config = false;
+  uuid_t uuid_config;
+  bool has_uuid_message = false;
+  uuid_t uuid_message;
+  catalog_kind8_t kind = (catalog_kind8_t) 0;
+  bool has_type = false;
+  Uint32_t type = 0;
+  timestamp_t from = INT64_MIN;   // The records overlapping from..to (both included)
+  timestamp_t to = INT64_MAX;
+};
+
+typedef std::function<void(const catalog_record_t &rRecord)> catalog_found_function_t;
+
+// A catalog file, mapped for queries
+struct catalog_t
+{
+  // Maps the catalog and checks its header and indexes. Returns false and sets rMessage on error.
+  bool Open(const char *pFileName, std::string &rMessage);
+
+  Uint64_t RecordCount() const { return p_header->record_count; }
+  std::string Path(const catalog_record_t &rRecord) const;
+
+  // Calls Found for every matching record, in order of first_timestamp. Uses the index of uuid_message or uuid_config
+  // if the query has one, otherwise the time order of the records.
+  void Query(const catalog_query_t &rQuery, const catalog_found_function_t &Found) const;
+
+private:
+  input_file_t file;
+  const catalog_file_header_t *p_header = nullptr;
+  const catalog_record_t *p_records = nullptr;
+  const char *p_paths = nullptr;
+
+  bool CheckIndex(Uint64_t Offset, std::string &rMessage) const;
+  void QueryIndex(Uint64_t IndexOffset, const uuid_t Uuid, const catalog_query_t &rQuery,
+                  const catalog_found_function_t &Found) const;
+};
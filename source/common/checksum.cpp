@@ -0,0 +1,270 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "checksum.h"
+#include <string.h>
+#include "decoder.h"
+
+// XOR is associative, so the 16 bit words can be combined in wider words and folded at the end. The words are counted
+// from the start of the data, which need not be aligned: all loads are unaligned and every step is a multiple of
+// 16 bit, so each 16 bit half of a wide word is one word of the data in either byte order.
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CHECKSUM_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CHECKSUM_TARGET(x)
+#else
+#include <cpuid.h>
+#define CHECKSUM_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+static inline Uint16_t Fold(Uint64_t Value)
+{
+  Value ^= Value >> 32;
+  Value ^= Value >> 16;
+  return (Uint16_t) Value;
+}
+
+// Words from pData up to Length, including a last odd byte, combined in a 64 bit word
+static inline Uint64_t XorTail(const Uint8_t *pData, size_t Length)
+{
+  Uint64_t value = 0;
+  while (Length >= sizeof(Uint64_t))
+  {
+    Uint64_t word;
+    memcpy(&word, pData, sizeof(word));
+    value ^= word;
+    pData += sizeof(Uint64_t);
+    Length -= sizeof(Uint64_t);
+  }
+  // The remaining bytes form the start of a zero padded 64 bit word, an odd last byte is the low byte of its word
+  Uint64_t word = 0;
+  memcpy(&word, pData, Length);
+  return value ^ word;
+}
+
+static Uint16_t CalcChecksumScalar(const void *pData, size_t Length)
+{
+  return Fold(XorTail((const Uint8_t*) pData, Length));
+}
+
+#ifdef CHECKSUM_X86
+
+CHECKSUM_TARGET("sse2")
+static Uint16_t CalcChecksumSse2(const void *pData, size_t Length)
+{
+  const Uint8_t *p_data = (const Uint8_t*) pData;
+  __m128i acc0 = _mm_setzero_si128();
+  __m128i acc1 = _mm_setzero_si128();
+  __m128i acc2 = _mm_setzero_si128();
+  __m128i acc3 = _mm_setzero_si128();
+  for (; Length >= 64; p_data += 64, Length -= 64)
+  {
+    acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i*) p_data));
+    acc1 = _mm_xor_si128(acc1, _mm_loadu_si128((const __m128i*) (p_data + 16)));
+    acc2 = _mm_xor_si128(acc2, _mm_loadu_si128((const __m128i*) (p_data + 32)));
+    acc3 = _mm_xor_si128(acc3, _mm_loadu_si128((const __m128i*) (p_data + 48)));
+  }
+  __m128i acc = _mm_xor_si128(_mm_xor_si128(acc0, acc1), _mm_xor_si128(acc2, acc3));
+
+  Uint64_t lanes[2];
+  _mm_storeu_si128((__m128i*) lanes, acc);
+  return Fold(lanes[0] ^ lanes[1] ^ XorTail(p_data, Length));
+}
+
+CHECKSUM_TARGET("avx2")
+static Uint16_t CalcChecksumAvx2(const void *pData, size_t Length)
+{
+  const Uint8_t *p_data = (const Uint8_t*) pData;
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  __m256i acc2 = _mm256_setzero_si256();
+  __m256i acc3 = _mm256_setzero_si256();
+  for (; Length >= 128; p_data += 128, Length -= 128)
+  {
+    acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i*) p_data));
+    acc1 = _mm256_xor_si256(acc1, _mm256_loadu_si256((const __m256i*) (p_data + 32)));
+    acc2 = _mm256_xor_si256(acc2, _mm256_loadu_si256((const __m256i*) (p_data + 64)));
+    acc3 = _mm256_xor_si256(acc3, _mm256_loadu_si256((const __m256i*) (p_data + 96)));
+  }
+  __m256i acc = _mm256_xor_si256(_mm256_xor_si256(acc0, acc1), _mm256_xor_si256(acc2, acc3));
+
+  Uint64_t lanes[4];
+  _mm256_storeu_si256((__m256i*) lanes, acc);
+  return Fold(lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3] ^ XorTail(p_data, Length));
+}
+
+CHECKSUM_TARGET("avx512f")
+static Uint16_t CalcChecksumAvx512(const void *pData, size_t Length)
+{
+  const Uint8_t *p_data = (const Uint8_t*) pData;
+  __m512i acc0 = _mm512_setzero_si512();
+  __m512i acc1 = _mm512_setzero_si512();
+  __m512i acc2 = _mm512_setzero_si512();
+  __m512i acc3 = _mm512_setzero_si512();
+  for (; Length >= 256; p_data += 256, Length -= 256)
+  {
+    acc0 = _mm512_xor_si512(acc0, _mm512_loadu_si512((const void*) p_data));
+    acc1 = _mm512_xor_si512(acc1, _mm512_loadu_si512((const void*) (p_data + 64)));
+    acc2 = _mm512_xor_si512(acc2, _mm512_loadu_si512((const void*) (p_data + 128)));
+    acc3 = _mm512_xor_si512(acc3, _mm512_loadu_si512((const void*) (p_data + 192)));
+  }
+  __m512i acc = _mm512_xor_si512(_mm512_xor_si512(acc0, acc1), _mm512_xor_si512(acc2, acc3));
+
+  Uint64_t lanes[8];
+  _mm512_storeu_si512((void*) lanes, acc);
+  Uint64_t value = XorTail(p_data, Length);
+  for (int i = 0; i < 8; ++i)
+  {
+    value ^= lanes[i];
+  }
+  return Fold(value);
+}
+
+struct cpu_features_t
+{
+  bool sse2;
+  bool avx2;
+  bool avx512;
+};
+
+// CPUID leaves 1 and 7 plus the register state the operating system saves on context switches (XCR0)
+static cpu_features_t DetectCpuFeatures()
+{
+  cpu_features_t features = { false, false, false };
+  unsigned int leaf1[4] = { 0, 0, 0, 0 };
+  unsigned int leaf7[4] = { 0, 0, 0, 0 };
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  memcpy(leaf1, info, sizeof(leaf1));
+  if (max_leaf >= 7)
+  {
+    __cpuidex(info, 7, 0);
+    memcpy(leaf7, info, sizeof(leaf7));
+  }
+#else
+  unsigned int max_leaf = __get_cpuid_max(0, NULL);
+  __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+  if (max_leaf >= 7)
+  {
+    __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+  }
+#endif
+  features.sse2 = (leaf1[3] & (1u << 26)) != 0;
+  if ((leaf1[2] & (1u << 27)) == 0)   // OSXSAVE, XCR0 can not be read
+  {
+    return features;
+  }
+#ifdef _MSC_VER
+  Uint64_t xcr0 = _xgetbv(0);
+#else
+  unsigned int xcr0_low, xcr0_high;
+  __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+  Uint64_t xcr0 = ((Uint64_t) xcr0_high << 32) | xcr0_low;
+#endif
+  bool ymm_state = (xcr0 & 0x06) == 0x06;   // SSE and AVX registers
+  bool zmm_state = (xcr0 & 0xE6) == 0xE6;   // additionally opmask and upper ZMM registers
+  features.avx2 = ymm_state && (leaf7[1] & (1u << 5)) != 0;
+  features.avx512 = zmm_state && (leaf7[1] & (1u << 16)) != 0;
+  return features;
+}
+
+#endif
+
+bool IsChecksumVariantAvailable(checksum_variant_t Variant)
+{
+#ifdef CHECKSUM_X86
+  static const cpu_features_t features = DetectCpuFeatures();
+  switch (Variant)
+  {
+    case checksum_scalar:
+      return true;
+    case checksum_sse2:
+      return features.sse2;
+    case checksum_avx2:
+      return features.avx2;
+    case checksum_avx512:
+      return features.avx512;
+    default:
+      return false;
+  }
+#else
+  return Variant == checksum_scalar;
+#endif
+}
+
+checksum_variant_t FastestChecksumVariant()
+{
+  static checksum_variant_t fastest = IsChecksumVariantAvailable(checksum_avx512) ? checksum_avx512
+                                    : IsChecksumVariantAvailable(checksum_avx2)   ? checksum_avx2
+                                    : IsChecksumVariantAvailable(checksum_sse2)   ? checksum_sse2
+                                                                                  : checksum_scalar;
+  return fastest;
+}
+
+const char* ChecksumVariantAsString(checksum_variant_t Variant)
+{
+  switch (Variant)
+  {
+    case checksum_scalar:
+      return "scalar";
+    case checksum_sse2:
+      return "SSE2";
+    case checksum_avx2:
+      return "AVX2";
+    case checksum_avx512:
+      return "AVX-512";
+    default:
+      return "unknown";
+  }
+}
+
+Uint16_t CalcChecksumVariant(checksum_variant_t Variant, const void *pData, size_t Length)
+{
+  switch (Variant)
+  {
+#ifdef CHECKSUM_X86
+    case checksum_sse2:
+      return CalcChecksumSse2(pData, Length);
+    case checksum_avx2:
+      return CalcChecksumAvx2(pData, Length);
+    case checksum_avx512:
+      return CalcChecksumAvx512(pData, Length);
+#endif
+    default:
+      return CalcChecksumScalar(pData, Length);
+  }
+}
+
+Uint16_t CalcChecksum(const void *pData, size_t Length)
+{
+  // Selected once, the function-local static is initialized thread safe
+  typedef Uint16_t (*checksum_function_t)(const void*, size_t);
+  static const checksum_function_t p_function =
+#ifdef CHECKSUM_X86
+      FastestChecksumVariant() == checksum_avx512 ? CalcChecksumAvx512
+    : FastestChecksumVariant() == checksum_avx2   ? CalcChecksumAvx2
+    : FastestChecksumVariant() == checksum_sse2   ? CalcChecksumSse2
+                                                  :
+#endif
+                                                    CalcChecksumScalar;
+  return p_function(pData, Length);
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ XOR checksum over 16 bit words used in all headers and data arrays. CalcChecksum (declared in decoder.h) picks the
+ fastest implementation the CPU supports on first use. The variants are exposed for testing and benchmarking.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "datatypes.h"
+
+enum checksum_variant_t
+{
+  checksum_scalar = 0,
+  checksum_sse2 = 1,
+  checksum_avx2 = 2,
+  checksum_avx512 = 3
+};
+
+// True if the variant was compiled in and the CPU (and operating system) supports it
+bool IsChecksumVariantAvailable(checksum_variant_t Variant);
+
+// The variant CalcChecksum uses
+checksum_variant_t FastestChecksumVariant();
+
+// Returns a static string, e.g. "AVX2"
+const char* ChecksumVariantAsString(checksum_variant_t Variant);
+
+// CalcChecksum with the given variant, which must be available
+Uint16_t CalcChecksumVariant(checksum_variant_t Variant, const void *pData, size_t Length);
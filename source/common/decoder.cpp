@@ -0,0 +1,904 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "decoder.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#ifdef USE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+#include "protobuf_wire.h"
+
+// Field numbers from Trend.proto, TimeSignal.proto and ClassificationData.proto, the TransferMessage ones are in
+// decoder.h
+static const int binary_data_field = 100;
+static const int trend_uuid_field = 1;
+static const int trend_number_of_packages_field = 3;
+static const int trend_package_number_field = 4;
+static const int timesignal_uuid_field = 1;
+static const int timesignal_job_data_uuid_field = 2;
+static const int timesignal_number_of_packages_field = 4;
+static const int timesignal_package_number_field = 5;
+static const int classification_data_uuid_field = 1;
+
+// Compressed time signals up to this uncompressed size are inflated in one go if the inflate backend is faster at that
+// than zlib's streaming inflate. Larger ones are streamed, so the memory needed stays bounded.
+static const size_t max_single_shot_size = 64 << 20;
+
+decode_buffer_t::~decode_buffer_t()
+{
+  if (p_inflate_stream)
+  {
+    (void) inflateEnd((z_stream*) p_inflate_stream);
+    delete (z_stream*) p_inflate_stream;
+  }
+#ifdef USE_LIBDEFLATE
+  if (p_decompressor)
+  {
+    libdeflate_free_decompressor((libdeflate_decompressor*) p_decompressor);
+  }
+#endif
+  free(p_data);
+}
+
+Uint8_t* decode_buffer_t::Reserve(size_t Size)
+{
+  if (Size > capacity)
+  {
+    Uint8_t *p_new_data = (Uint8_t*) realloc(p_data, Size);
+    if (p_new_data == NULL)
+    {
+      return NULL;
+    }
+    p_data = p_new_data;
+    capacity = Size;
+  }
+  return p_data;
+}
+
+int UncompressData(Uint8_t *pDest, unsigned long *pDestLen, const Uint8_t *pSource, unsigned long SourceLen,
+                   int WindowBits)
+{
+  z_stream stream;
+  int err = 0;
+
+  stream.next_in = (Bytef*) pSource;
+  stream.avail_in = (uInt) SourceLen;
+  /* Check for source > 4G on 64-bit machine: */
+  if ((uLong) stream.avail_in != SourceLen) return Z_BUF_ERROR;
+
+  stream.next_out = pDest;
+  stream.avail_out = (uInt) *pDestLen;
+  if ((uLong) stream.avail_out != *pDestLen) return Z_BUF_ERROR;
+
+  stream.zalloc = (alloc_func) 0;
+  stream.zfree = (free_func) 0;
+
+  err = inflateInit2(&stream, WindowBits);
+  if (err != Z_OK) return err;
+
+  err = inflate(&stream, Z_FINISH);
+  if (err != Z_STREAM_END)
+  {
+    (void) inflateEnd(&stream);
+    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) return Z_DATA_ERROR;
+    return err;
+  }
+  *pDestLen = stream.total_out;
+
+  err = inflateEnd(&stream);
+  return err;
+}
+
+// Returns the zlib stream of rBuffer ready for a new stream with the given window bits, creates it on first use
+static z_stream* ResetInflateStream(decode_buffer_t &rBuffer, int WindowBits, int &rErr)
+{
+  z_stream *p_stream = (z_stream*) rBuffer.p_inflate_stream;
+  rErr = Z_OK;
+
+  if (p_stream == NULL)
+  {
+    p_stream = new z_stream();
+    p_stream->zalloc = (alloc_func) 0;
+    p_stream->zfree = (free_func) 0;
+    rErr = inflateInit2(p_stream, WindowBits);
+    if (rErr != Z_OK)
+    {
+      delete p_stream;
+      return NULL;
+    }
+    rBuffer.p_inflate_stream = p_stream;
+    rBuffer.inflate_window_bits = WindowBits;
+  }
+  else
+  {
+    rErr = rBuffer.inflate_window_bits == WindowBits ? inflateReset(p_stream) : inflateReset2(p_stream, WindowBits);
+    if (rErr != Z_OK) return NULL;
+    rBuffer.inflate_window_bits = WindowBits;
+  }
+  return p_stream;
+}
+
+#ifdef USE_LIBDEFLATE
+// Single-shot inflate with libdeflate, returns zlib error codes like the zlib variant
+static int UncompressDataLibdeflate(decode_buffer_t &rBuffer, Uint8_t *pDest, unsigned long *pDestLen,
+                                    const Uint8_t *pSource, unsigned long SourceLen, int WindowBits)
+{
+  if (rBuffer.p_decompressor == NULL)
+  {
+    rBuffer.p_decompressor = libdeflate_alloc_decompressor();
+    if (rBuffer.p_decompressor == NULL) return Z_MEM_ERROR;
+  }
+  libdeflate_decompressor *p_decompressor = (libdeflate_decompressor*) rBuffer.p_decompressor;
+
+  // Like zlib, data behind the end of the stream is ignored and a stream shorter than the buffer is no error
+  size_t in_length = 0;
+  size_t out_length = 0;
+  libdeflate_result result =
+      WindowBits == 31 ? libdeflate_gzip_decompress_ex(p_decompressor, pSource, SourceLen, pDest, *pDestLen, &in_length,
+                                                       &out_length)
+                       : libdeflate_zlib_decompress_ex(p_decompressor, pSource, SourceLen, pDest, *pDestLen, &in_length,
+                                                       &out_length);
+  switch (result)
+  {
+    case LIBDEFLATE_SUCCESS:
+    case LIBDEFLATE_SHORT_OUTPUT:
+      *pDestLen = (unsigned long) out_length;
+      return Z_OK;
+    case LIBDEFLATE_INSUFFICIENT_SPACE:
+      return Z_BUF_ERROR;
+    default:
+      return Z_DATA_ERROR;
+  }
+}
+#endif
+
+int UncompressData(decode_buffer_t &rBuffer, Uint8_t *pDest, unsigned long *pDestLen, const Uint8_t *pSource,
+                   unsigned long SourceLen, int WindowBits)
+{
+#ifdef USE_LIBDEFLATE
+  if (rBuffer.inflate_backend == inflate_backend_libdeflate)
+  {
+    return UncompressDataLibdeflate(rBuffer, pDest, pDestLen, pSource, SourceLen, WindowBits);
+  }
+#endif
+  int err = Z_OK;
+  z_stream *p_stream = ResetInflateStream(rBuffer, WindowBits, err);
+  if (p_stream == NULL) return err;
+
+  p_stream->next_in = (Bytef*) pSource;
+  p_stream->avail_in = (uInt) SourceLen;
+  if ((uLong) p_stream->avail_in != SourceLen) return Z_BUF_ERROR;
+
+  p_stream->next_out = pDest;
+  p_stream->avail_out = (uInt) *pDestLen;
+  if ((uLong) p_stream->avail_out != *pDestLen) return Z_BUF_ERROR;
+
+  err = inflate(p_stream, Z_FINISH);
+  if (err != Z_STREAM_END)
+  {
+    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && p_stream->avail_in == 0)) return Z_DATA_ERROR;
+    return err;
+  }
+  *pDestLen = p_stream->total_out;
+  return Z_OK;
+}
+
+const char* CompressionAsString(compression32_t Compression)
+{
+  switch (Compression)
+  {
+    case no_compression:
+      return "no compression";
+    case zlib:
+      return "zlib";
+    case int24:
+      return "int24";
+    case gzip:
+      return "gzip";
+    default:
+      return "unknown";
+  }
+}
+
+inflate_backend_t DefaultInflateBackend()
+{
+#ifdef USE_LIBDEFLATE
+  return inflate_backend_libdeflate;
+#else
+  return inflate_backend_zlib;
+#endif
+}
+
+bool IsInflateBackendAvailable(inflate_backend_t Backend)
+{
+  switch (Backend)
+  {
+    case inflate_backend_zlib:
+      return true;
+#ifdef USE_LIBDEFLATE
+    case inflate_backend_libdeflate:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+const char* InflateBackendAsString(inflate_backend_t Backend)
+{
+  switch (Backend)
+  {
+    case inflate_backend_zlib:
+      return "zlib";
+    case inflate_backend_libdeflate:
+      return "libdeflate";
+    default:
+      return "unknown";
+  }
+}
+
+const char* DecodeResultAsString(decode_result_t Result)
+{
+  switch (Result)
+  {
+    case decode_ok:
+      return "Success";
+    case decode_error_header_size:
+      return "Header size invalid";
+    case decode_error_header_version:
+      return "Header version not supported";
+    case decode_error_header_checksum:
+      return "Header checksum not matching";
+    case decode_error_data_size:
+      return "Data size mismatch";
+    case decode_error_data_checksum:
+      return "Data checksum not matching";
+    case decode_error_sample_type:
+      return "Sample data type not supported";
+    case decode_error_uncompress:
+      return "Could not uncompress data";
+    case decode_error_uncompressed_length:
+      return "Uncompressed length does not match expected length";
+    default:
+      return "Unknown error";
+  }
+}
+
+static bool IsTransferMessageContentField(int FieldNumber)
+{
+  return (FieldNumber >= 10 && FieldNumber <= 23) || (FieldNumber >= 100 && FieldNumber <= 104);
+}
+
+input_kind_t PeekInputKind(byte_span_t Input)
+{
+  input_kind_t kind = { envelope_unknown, 0 };
+  if (Input.size == 0)
+  {
+    return kind;
+  }
+
+  // Field number 0 is not valid in protobuf, so a first byte below 8 is the low byte of the raw header version
+  if (Input.p_data[0] < 8)
+  {
+    kind.envelope = envelope_raw;
+    return kind;
+  }
+
+  // Tags of the fields in question have at most two bytes
+  Uint32_t tag = Input.p_data[0] & 0x7F;
+  if ((Input.p_data[0] & 0x80) != 0)
+  {
+    if (Input.size < 2 || (Input.p_data[1] & 0x80) != 0)
+    {
+      return kind;
+    }
+    tag |= (Uint32_t) Input.p_data[1] << 7;
+  }
+  if (WireTagType(tag) != wire_type_length_delimited)
+  {
+    return kind;
+  }
+
+  // The uuids identifying a bare message are its first fields, and protobuf writes the fields in order
+  int field_number = WireTagFieldNumber(tag);
+  if (IsTransferMessageContentField(field_number))
+  {
+    kind.envelope = envelope_transfer_message;
+    kind.transfer_message_field = field_number;
+  }
+  else if (field_number < 10)
+  {
+    kind.envelope = envelope_protobuf;
+  }
+  return kind;
+}
+
+int TransferMessageContentField(byte_span_t Input)
+{
+  return PeekInputKind(Input).transfer_message_field;
+}
+
+static envelope_t FindBinaryData(byte_span_t Input, int TransferMessageField, int UuidField, byte_span_t &rBinaryData)
+{
+  // The first tag tells which of the containers below to try, only inputs it does not fit are tried with each of them
+  input_kind_t kind = PeekInputKind(Input);
+  if (kind.envelope == envelope_raw
+      || (kind.envelope == envelope_transfer_message && kind.transfer_message_field != TransferMessageField))
+  {
+    rBinaryData = Input;
+    return envelope_raw;
+  }
+
+  // TransferMessage with the expected content set
+  if (kind.envelope != envelope_protobuf)
+  {
+    int content_field = 0;
+    byte_span_t content = { NULL, 0 };
+    if (ScanMessage(Input, [&](int FieldNumber, byte_span_t Value)
+    {
+      if (IsTransferMessageContentField(FieldNumber))
+      {
+        content_field = FieldNumber;
+        content = Value;
+      }
+    }) && content_field == TransferMessageField)
+    {
+      byte_span_t binary_data = { NULL, 0 };
+      if (ScanMessage(content, [&](int FieldNumber, byte_span_t Value)
+      {
+        if (FieldNumber == binary_data_field)
+        {
+          binary_data = Value;
+        }
+      }))
+      {
+        rBinaryData = binary_data;
+        return envelope_transfer_message;
+      }
+    }
+  }
+
+  // Bare message, only accepted if its uuid is set
+  if (kind.envelope != envelope_transfer_message)
+  {
+    byte_span_t uuid = { NULL, 0 };
+    byte_span_t binary_data = { NULL, 0 };
+    if (ScanMessage(Input, [&](int FieldNumber, byte_span_t Value)
+    {
+      if (FieldNumber == UuidField)
+      {
+        uuid = Value;
+      }
+      else if (FieldNumber == binary_data_field)
+      {
+        binary_data = Value;
+      }
+    }) && uuid.size > 0)
+    {
+      rBinaryData = binary_data;
+      return envelope_protobuf;
+    }
+  }
+
+  rBinaryData = Input;
+  return envelope_raw;
+}
+
+envelope_t FindTrendBinaryData(byte_span_t Input, byte_span_t &rBinaryData)
+{
+  return FindBinaryData(Input, transfer_message_trend, trend_uuid_field, rBinaryData);
+}
+
+envelope_t FindTimesignalBinaryData(byte_span_t Input, byte_span_t &rBinaryData)
+{
+  return FindBinaryData(Input, transfer_message_timesignal, timesignal_job_data_uuid_field, rBinaryData);
+}
+
+envelope_t FindClassificationBinaryData(byte_span_t Input, byte_span_t &rBinaryData)
+{
+  return FindBinaryData(Input, transfer_message_classification_data, classification_data_uuid_field, rBinaryData);
+}
+
+static bool FindPackage(byte_span_t Input, int TransferMessageField, int UuidField, int NumberOfPackagesField,
+                        int PackageNumberField, package_t &rPackage)
+{
+  rPackage = package_t();
+
+  input_kind_t kind = PeekInputKind(Input);
+  if (kind.envelope == envelope_raw
+      || (kind.envelope == envelope_transfer_message && kind.transfer_message_field != TransferMessageField))
+  {
+    return false;
+  }
+
+  // Content of a TransferMessage, otherwise the input is taken as bare message
+  int content_field = 0;
+  byte_span_t content = { NULL, 0 };
+  byte_span_t message = Input;
+  rPackage.envelope = envelope_protobuf;
+  if (kind.envelope != envelope_protobuf && ScanMessage(Input, [&](int FieldNumber, byte_span_t Value)
+  {
+    if (IsTransferMessageContentField(FieldNumber))
+    {
+      content_field = FieldNumber;
+      content = Value;
+    }
+  }) && content_field == TransferMessageField)
+  {
+    message = content;
+    rPackage.envelope = envelope_transfer_message;
+  }
+
+  if (!ScanMessage(message, [&](int FieldNumber, byte_span_t Value)
+  {
+    if (FieldNumber == UuidField)
+    {
+      rPackage.uuid = Value;
+    }
+    else if (FieldNumber == binary_data_field)
+    {
+      rPackage.binary_data = Value;
+    }
+  }, [&](int FieldNumber, Uint64_t Value)
+  {
+    // int32 fields, negative values are sign extended to 64 bit
+    if (FieldNumber == NumberOfPackagesField)
+    {
+      rPackage.number_of_packages = (Int32_t) Value;
+    }
+    else if (FieldNumber == PackageNumberField)
+    {
+      rPackage.package_number = (Int32_t) Value;
+    }
+  }))
+  {
+    return false;
+  }
+  return rPackage.envelope == envelope_transfer_message || rPackage.uuid.size > 0;
+}
+
+bool FindTrendPackage(byte_span_t Input, package_t &rPackage)
+{
+  return FindPackage(Input, transfer_message_trend, trend_uuid_field, trend_number_of_packages_field,
+                     trend_package_number_field, rPackage);
+}
+
+bool FindTimesignalPackage(byte_span_t Input, package_t &rPackage)
+{
+  return FindPackage(Input, transfer_message_timesignal, timesignal_uuid_field,
+                     timesignal_number_of_packages_field, timesignal_package_number_field, rPackage);
+}
+
+// Provides ExpectedSize bytes of the data array with the given alignment. Uncompressed data is used in place if it is
+// suitably aligned, otherwise it is copied into the decode buffer. Compressed data is inflated into the decode buffer.
+static decode_result_t ExpandData(compression32_t Compression, byte_span_t Data, size_t ExpectedSize, size_t Alignment,
+                                  decode_buffer_t &rBuffer, const Uint8_t *&rpExpanded)
+{
+  if (Compression == no_compression)
+  {
+    if (Data.size < ExpectedSize)
+    {
+      return decode_error_data_size;
+    }
+    if (((uintptr_t) Data.p_data % Alignment) == 0)
+    {
+      rpExpanded = Data.p_data;
+      return decode_ok;
+    }
+    Uint8_t *p_aligned = rBuffer.Reserve(ExpectedSize);
+    if (p_aligned == NULL && ExpectedSize > 0)
+    {
+      return decode_error_data_size;
+    }
+    memcpy(p_aligned, Data.p_data, ExpectedSize);
+    rpExpanded = p_aligned;
+    return decode_ok;
+  }
+
+  Uint8_t *p_uncompressed = rBuffer.Reserve(ExpectedSize);
+  if (p_uncompressed == NULL && ExpectedSize > 0)
+  {
+    return decode_error_uncompressed_length;
+  }
+  unsigned long length = (unsigned long) ExpectedSize;
+  if (length != ExpectedSize)
+  {
+    return decode_error_uncompressed_length;
+  }
+  if (UncompressData(rBuffer, p_uncompressed, &length, Data.p_data, (unsigned long) Data.size,
+                     Compression == zlib ? 15 : 31) != Z_OK)
+  {
+    return decode_error_uncompress;
+  }
+  if (length != ExpectedSize)
+  {
+    return decode_error_uncompressed_length;
+  }
+  rpExpanded = p_uncompressed;
+  return decode_ok;
+}
+
+decode_result_t DecodeTrendHeaderOnly(byte_span_t Input, trend_view_t &rView)
+{
+  rView = trend_view_t();
+  rView.envelope = FindTrendBinaryData(Input, rView.binary_data);
+
+  const byte_span_t &binary_data = rView.binary_data;
+  trend_header_t &header = rView.header;
+  if (binary_data.size < sizeof(trend_header_t))
+  {
+    return decode_error_header_size;
+  }
+  memcpy(&header, binary_data.p_data, sizeof(trend_header_t));
+
+  if (CalcChecksum(&header, sizeof(trend_header_t) - 2) != header.checksum_header)
+  {
+    return decode_error_header_checksum;
+  }
+
+  if (binary_data.size != (size_t) header.header_size + (Uint32_t) header.byte_count)
+  {
+    return decode_error_data_size;
+  }
+  rView.data.p_data = binary_data.p_data + header.header_size;
+  rView.data.size = (Uint32_t) header.byte_count;
+
+  if (header.value_count < 0)
+  {
+    return decode_error_uncompressed_length;
+  }
+  return decode_ok;
+}
+
+decode_result_t DecodeTrend(byte_span_t Input, decode_buffer_t &rBuffer, trend_view_t &rView)
+{
+  decode_result_t result = DecodeTrendHeaderOnly(Input, rView);
+  if (result != decode_ok)
+  {
+    return result;
+  }
+  const trend_header_t &header = rView.header;
+  if (CalcChecksum(rView.data.p_data, rView.data.size) != header.checksum_data)
+  {
+    return decode_error_data_checksum;
+  }
+
+  const Uint8_t *p_entries = NULL;
+  result = ExpandData(header.compression, rView.data, header.value_count * sizeof(trend_entry_t),
+                      alignof(trend_entry_t), rBuffer, p_entries);
+  rView.p_entries = (const trend_entry_t*) p_entries;
+  return result;
+}
+
+static size_t SampleTypeSize(sample_datatype32_t SampleType)
+{
+  switch (SampleType)
+  {
+    case data_int8_t:
+    case data_uint8_t:
+      return sizeof(Int8_t);
+    case data_int16_t:
+    case data_uint16_t:
+      return sizeof(Int16_t);
+    case data_int32_t:
+    case data_uint32_t:
+      return sizeof(Int32_t);
+    case data_int64_t:
+    case data_uint64_t:
+      return sizeof(Int64_t);
+    case data_float32_t:
+      return sizeof(Float32_t);
+    case data_float64_t:
+      return sizeof(Float64_t);
+    default:
+      return 0;
+  }
+}
+
+decode_result_t DecodeTimesignalHeaderOnly(byte_span_t Input, timesignal_view_t &rView)
+{
+  rView = timesignal_view_t();
+  rView.envelope = FindTimesignalBinaryData(Input, rView.binary_data);
+
+  const byte_span_t &binary_data = rView.binary_data;
+  timesignal_header_t &header = rView.header;
+  memcpy(&header, binary_data.p_data,
+         binary_data.size < sizeof(timesignal_header_t) ? binary_data.size : sizeof(timesignal_header_t));
+  if (binary_data.size < sizeof(timesignal_header_v3_t) || header.header_size < sizeof(timesignal_header_v3_t)
+      || header.header_size > sizeof(timesignal_header_t) || header.header_size > binary_data.size)
+  {
+    return decode_error_header_size;
+  }
+
+  if (4 == header.version)
+  {
+    rView.checksum_header = header.checksum_header;
+    rView.checksum_data = header.checksum_data;
+  }
+  else
+  {
+    const timesignal_header_v3_t *p_v3_header = (const timesignal_header_v3_t*) &header;
+    rView.checksum_header = p_v3_header->checksum_header;
+    rView.checksum_data = p_v3_header->checksum_data;
+  }
+
+  if (CalcChecksum(&header, header.header_size - 2) != rView.checksum_header)
+  {
+    return decode_error_header_checksum;
+  }
+  // Do not leave data array bytes in the fields a version 3 header does not have
+  memset((Uint8_t*) &header + header.header_size, 0, sizeof(timesignal_header_t) - header.header_size);
+
+  if (binary_data.size != header.header_size + header.byte_count)
+  {
+    return decode_error_data_size;
+  }
+  rView.data.p_data = binary_data.p_data + header.header_size;
+  rView.data.size = (size_t) header.byte_count;
+
+  rView.sample_size = SampleTypeSize(header.sample_type);
+  if (rView.sample_size == 0)
+  {
+    return decode_error_sample_type;
+  }
+  if (header.sample_count > SIZE_MAX / rView.sample_size)
+  {
+    return decode_error_uncompressed_length;
+  }
+  return decode_ok;
+}
+
+decode_result_t DecodeTimesignalHeader(byte_span_t Input, timesignal_view_t &rView)
+{
+  decode_result_t result = DecodeTimesignalHeaderOnly(Input, rView);
+  if (result == decode_ok && CalcChecksum(rView.data.p_data, rView.data.size) != rView.checksum_data)
+  {
+    return decode_error_data_checksum;
+  }
+  return result;
+}
+
+decode_result_t DecodeTimesignal(byte_span_t Input, decode_buffer_t &rBuffer, timesignal_view_t &rView)
+{
+  decode_result_t result = DecodeTimesignalHeader(Input, rView);
+  if (result != decode_ok)
+  {
+    return result;
+  }
+  const timesignal_header_t &header = rView.header;
+  const Uint8_t *p_samples = NULL;
+  result = ExpandData(header.compression, rView.data, (size_t) header.sample_count * rView.sample_size,
+                      rView.sample_size, rBuffer, p_samples);
+  rView.p_samples = p_samples;
+  return result;
+}
+
+decode_result_t StreamTimesignalSamples(const timesignal_view_t &rView, decode_buffer_t &rBuffer, size_t BlockSize,
+                                        const sample_block_function_t &rBlock)
+{
+  const size_t sample_size = rView.sample_size;
+  const size_t sample_count = (size_t) rView.header.sample_count;
+  const size_t block_samples = BlockSize / sample_size > 0 ? BlockSize / sample_size : 1;
+  const size_t block_size = block_samples * sample_size;
+
+  if (rView.header.compression == no_compression)
+  {
+    if (rView.data.size < sample_count * sample_size)
+    {
+      return decode_error_data_size;
+    }
+    // Blocks are taken in place, only misaligned data is copied block by block
+    bool is_aligned = ((uintptr_t) rView.data.p_data % sample_size) == 0;
+    if (!is_aligned && rBuffer.Reserve(block_size) == NULL)
+    {
+      return decode_error_data_size;
+    }
+    for (size_t first = 0; first < sample_count; first += block_samples)
+    {
+      size_t count = sample_count - first < block_samples ? sample_count - first : block_samples;
+      const Uint8_t *p_block = rView.data.p_data + first * sample_size;
+      if (!is_aligned)
+      {
+        memcpy(rBuffer.p_data, p_block, count * sample_size);
+        p_block = rBuffer.p_data;
+      }
+      rBlock(p_block, first, count);
+    }
+    return decode_ok;
+  }
+
+  if (rBuffer.inflate_backend != inflate_backend_zlib && sample_count * sample_size <= max_single_shot_size)
+  {
+    const Uint8_t *p_samples = NULL;
+    decode_result_t result = ExpandData(rView.header.compression, rView.data, sample_count * sample_size, sample_size,
+                                        rBuffer, p_samples);
+    if (result != decode_ok)
+    {
+      return result;
+    }
+    for (size_t first = 0; first < sample_count; first += block_samples)
+    {
+      rBlock(p_samples + first * sample_size, first,
+             sample_count - first < block_samples ? sample_count - first : block_samples);
+    }
+    return decode_ok;
+  }
+
+  int err = Z_OK;
+  z_stream *p_stream = ResetInflateStream(rBuffer, rView.header.compression == zlib ? 15 : 31, err);
+  Uint8_t *p_block = rBuffer.Reserve(block_size);
+  if (p_stream == NULL || p_block == NULL)
+  {
+    return decode_error_uncompress;
+  }
+
+  const Uint8_t *p_input = rView.data.p_data;
+  size_t input_left = rView.data.size;
+  size_t pending = 0;   // Inflated bytes in the block not handed out yet, less than one sample after each round
+  size_t first = 0;
+  for (;;)
+  {
+    if (p_stream->avail_in == 0 && input_left > 0)
+    {
+      // avail_in is 32 bit, larger inputs are fed in pieces
+      uInt chunk = input_left > UINT32_MAX ? UINT32_MAX : (uInt) input_left;
+      p_stream->next_in = (Bytef*) p_input;
+      p_stream->avail_in = chunk;
+      p_input += chunk;
+      input_left -= chunk;
+    }
+    p_stream->next_out = p_block + pending;
+    p_stream->avail_out = (uInt) (block_size - pending);
+
+    err = inflate(p_stream, Z_NO_FLUSH);
+    if (err != Z_OK && err != Z_STREAM_END)
+    {
+      return decode_error_uncompress;
+    }
+
+    pending = block_size - p_stream->avail_out;
+    size_t count = pending / sample_size;
+    if (count > sample_count - first)
+    {
+      return decode_error_uncompressed_length;
+    }
+    if (count > 0)
+    {
+      rBlock(p_block, first, count);
+      first += count;
+      pending -= count * sample_size;
+      memmove(p_block, p_block + count * sample_size, pending);
+    }
+
+    if (err == Z_STREAM_END)
+    {
+      break;
+    }
+    if (p_stream->avail_in == 0 && input_left == 0 && p_stream->avail_out > 0)
+    {
+      // Input consumed but the stream is not finished
+      return decode_error_uncompress;
+    }
+  }
+  return first == sample_count && pending == 0 ? decode_ok : decode_error_uncompressed_length;
+}
+
+decode_result_t DecodeClassificationHeaderOnly(byte_span_t Input, classification_view_t &rView)
+{
+  rView = classification_view_t();
+  rView.envelope = FindClassificationBinaryData(Input, rView.binary_data);
+
+  const byte_span_t &binary_data = rView.binary_data;
+  classification_header_t &header = rView.header;
+  if (binary_data.size < sizeof(Uint16_t))
+  {
+    return decode_error_header_size;
+  }
+
+  Uint16_t header_version = 0;
+  memcpy(&header_version, binary_data.p_data, sizeof(Uint16_t));
+  switch (header_version)
+  {
+    case CLASSIFICATION_DATA_HEADER_VERSION:
+    {
+      if (binary_data.size < sizeof(classification_header_t))
+      {
+        return decode_error_header_size;
+      }
+      memcpy(&header, binary_data.p_data, sizeof(classification_header_t));
+      break;
+    }
+    case 1:
+    {
+      classification_header_v1_t header_v1;
+      if (binary_data.size < sizeof(classification_header_v1_t))
+      {
+        return decode_error_header_size;
+      }
+      memcpy(&header_v1, binary_data.p_data, sizeof(classification_header_v1_t));
+      if (CalcChecksum(&header_v1, sizeof(classification_header_v1_t) - 2) != header_v1.checksum_header)
+      {
+        return decode_error_header_checksum;
+      }
+
+      header.version = header_v1.version;
+      header.header_size = header_v1.header_size;
+      memcpy(header.serial_number, header_v1.serial_number, sizeof(header.serial_number));
+      memcpy(header.comment, header_v1.comment, sizeof(header.comment));
+      header.compression = header_v1.compression;
+      memcpy(header.uuid_characteristic_value_config, header_v1.uuid_characteristic_value_config, sizeof(uuid_t));
+      memcpy(header.uuid_classification_data, header_v1.uuid_classification_data, sizeof(uuid_t));
+      header.data_type = header_v1.data_type;
+      header.period_type = header_v1.period_type;
+      header.start_timestamp = header_v1.start_timestamp;
+      header.end_timestamp = header_v1.end_timestamp;
+      header.modified_timestamp = header_v1.modified_timestamp;
+      header.close_timestamp = -1;
+      header.dimensions[0] = header_v1.dimensions[0];
+      header.dimensions[1] = header_v1.dimensions[1];
+      header.sample_rate = header_v1.sample_rate;
+      memcpy(header.unused, header_v1.unused, sizeof(header.unused));
+      header.sample_count = header_v1.sample_count;
+      header.byte_count = header_v1.byte_count;
+      header.checksum_data = header_v1.checksum_data;
+      header.checksum_header = CalcChecksum(&header, sizeof(classification_header_t) - 2);
+      break;
+    }
+    default:
+      return decode_error_header_version;
+  }
+
+  if (CalcChecksum(&header, sizeof(classification_header_t) - 2) != header.checksum_header)
+  {
+    return decode_error_header_checksum;
+  }
+
+  if (binary_data.size != (size_t) header.header_size + header.byte_count)
+  {
+    return decode_error_data_size;
+  }
+  rView.data.p_data = binary_data.p_data + header.header_size;
+  rView.data.size = header.byte_count;
+
+  rView.value_count = header.dimensions[0].num_classes;
+  if (header.dimensions[1].num_classes > 0)
+  {
+    rView.value_count *= header.dimensions[1].num_classes;
+  }
+  return decode_ok;
+}
+
+decode_result_t DecodeClassification(byte_span_t Input, decode_buffer_t &rBuffer, classification_view_t &rView)
+{
+  decode_result_t result = DecodeClassificationHeaderOnly(Input, rView);
+  if (result != decode_ok)
+  {
+    return result;
+  }
+  const classification_header_t &header = rView.header;
+  if (CalcChecksum(rView.data.p_data, rView.data.size) != header.checksum_data)
+  {
+    return decode_error_data_checksum;
+  }
+
+  const Uint8_t *p_values = NULL;
+  result = ExpandData(header.compression, rView.data, rView.value_count * sizeof(Uint64_t), alignof(Uint64_t),
+                      rBuffer, p_values);
+  rView.p_values = (const Uint64_t*) p_values;
+  return result;
+}
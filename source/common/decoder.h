@@ -0,0 +1,208 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Decoding core shared by all converters and linkable as libsmartcheck_decoder.
+ The Decode* functions take the complete input (TransferMessage, bare protobuf message or raw binary), locate the
+ binary data without building protobuf message objects, verify the checksums and inflate the data array if needed.
+ The returned views point into the input or into the caller owned decode buffer, nothing else is copied. The input and
+ the decode buffer must therefore outlive the view.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+#include "datatypes.h"
+
+// Read only view on a byte range owned by somebody else
+struct byte_span_t
+{
+  const Uint8_t *p_data;
+  size_t size;
+};
+
+// Content fields of smartcheck::TransferMessage (TransferMessage.proto) the converters take
+enum transfer_message_field_t
+{
+  transfer_message_device_config = 20,
+  transfer_message_timesignal = 101,
+  transfer_message_trend = 103,
+  transfer_message_classification_data = 104
+};
+
+// Container format the binary data was found in
+enum envelope_t
+{
+  envelope_unknown = 0,
+  envelope_transfer_message = 1,  // smartcheck::TransferMessage with the matching oneof field set
+  envelope_protobuf = 2,          // Bare smartcheck::Trend, smartcheck::TimeSignal or smartcheck::ClassificationData
+  envelope_raw = 3                // Header and data array without protobuf container
+};
+
+enum decode_result_t
+{
+  decode_ok = 0,
+  decode_error_header_size = 1,           // Input too small for the header or header_size out of range
+  decode_error_header_version = 2,        // Unknown header version
+  decode_error_header_checksum = 3,
+  decode_error_data_size = 4,             // header_size + byte_count does not match the binary data size
+  decode_error_data_checksum = 5,
+  decode_error_sample_type = 6,           // Unknown sample data type
+  decode_error_uncompress = 7,
+  decode_error_uncompressed_length = 8
+};
+
+// Implementations of the single-shot inflate used when the uncompressed size is known from the header. zlib-ng in
+// zlib compatible mode can be used in place of zlib without any change.
+enum inflate_backend_t
+{
+  inflate_backend_zlib = 0,
+  inflate_backend_libdeflate = 1    // Only available if built with USE_LIBDEFLATE
+};
+
+// The fastest backend the library was built with
+inflate_backend_t DefaultInflateBackend();
+
+// Scratch memory for inflated data arrays. Owned by the caller and reused across Decode* calls, grows on demand.
+// The zlib stream is kept as well, so decoding many inputs only resets it instead of allocating a new one each time.
+struct decode_buffer_t
+{
+  Uint8_t *p_data = nullptr;
+  size_t capacity = 0;
+  void *p_inflate_stream = nullptr;   // z_stream, created on first use
+  int inflate_window_bits = 0;
+  inflate_backend_t inflate_backend = DefaultInflateBackend();
+  void *p_decompressor = nullptr;     // libdeflate_decompressor, created on first use
+
+  decode_buffer_t() = default;
+  decode_buffer_t(const decode_buffer_t&) = delete;
+  decode_buffer_t& operator=(const decode_buffer_t&) = delete;
+  ~decode_buffer_t();
+
+  Uint8_t* Reserve(size_t Size);
+};
+
+struct trend_view_t
+{
+  envelope_t envelope;
+  byte_span_t binary_data;          // Header and data array
+  trend_header_t header;            // Copy of the header
+  byte_span_t data;                 // Data array as stored in the input (possibly compressed)
+  const trend_entry_t *p_entries;   // header.value_count entries
+};
+
+struct timesignal_view_t
+{
+  envelope_t envelope;
+  byte_span_t binary_data;          // Header and data array
+  timesignal_header_t header;       // Copy of the header. Fields behind rotational_frequency are zero for version 3.
+  Uint16_t checksum_data;           // Taken from the header layout matching header.version
+  Uint16_t checksum_header;
+  byte_span_t data;                 // Data array as stored in the input (possibly compressed)
+  const void *p_samples;            // header.sample_count samples of header.sample_type
+  size_t sample_size;               // Size of one sample in bytes
+};
+
+struct classification_view_t
+{
+  envelope_t envelope;
+  byte_span_t binary_data;          // Header and data array
+  classification_header_t header;   // Copy of the header, version 1 headers are converted to the current layout
+  byte_span_t data;                 // Data array as stored in the input (possibly compressed)
+  const Uint64_t *p_values;         // Matrix with num_classes(d0) * max(1, num_classes(d1)) counters
+  size_t value_count;
+};
+
+// XOR over all 16 bit words, a last odd byte is padded with a zero byte. Vectorized, see checksum.h
+Uint16_t CalcChecksum(const void *pData, size_t Length);
+
+// Inflates a complete zlib (WindowBits 15) or gzip (WindowBits 31) stream. Returns a zlib error code.
+int UncompressData(Uint8_t *pDest, unsigned long *pDestLen, const Uint8_t *pSource, unsigned long SourceLen,
+                   int WindowBits);
+
+// Same as UncompressData, but uses the inflate backend of rBuffer and reuses its zlib stream or decompressor
+int UncompressData(decode_buffer_t &rBuffer, Uint8_t *pDest, unsigned long *pDestLen, const Uint8_t *pSource,
+                   unsigned long SourceLen, int WindowBits);
+
+// Returns a static string, e.g. "zlib"
+const char* CompressionAsString(compression32_t Compression);
+
+bool IsInflateBackendAvailable(inflate_backend_t Backend);
+
+// Returns a static string, e.g. "libdeflate"
+const char* InflateBackendAsString(inflate_backend_t Backend);
+
+// Returns a static string describing the result, e.g. "Header checksum not matching"
+const char* DecodeResultAsString(decode_result_t Result);
+
+// Finds the binary_data field inside a TransferMessage or a bare Trend/TimeSignal/ClassificationData message. Falls back
+// to the whole input as raw binary data.
+envelope_t FindTrendBinaryData(byte_span_t Input, byte_span_t &rBinaryData);
+envelope_t FindTimesignalBinaryData(byte_span_t Input, byte_span_t &rBinaryData);
+envelope_t FindClassificationBinaryData(byte_span_t Input, byte_span_t &rBinaryData);
+
+// What an input is, told from its first tag without walking the message
+struct input_kind_t
+{
+  envelope_t envelope;            // envelope_unknown if the first bytes fit none of the formats
+  int transfer_message_field;     // Content field of a TransferMessage, 0 otherwise
+};
+
+// Looks at the first tag only: a TransferMessage starts with its oneof content field (10 to 23, 100 to 104), a bare
+// message with one of its first fields (uuid), raw binary data with the header version, which is no valid tag.
+// Does not check that the rest of the input is valid.
+input_kind_t PeekInputKind(byte_span_t Input);
+
+// Field number of the content set in a TransferMessage, 0 if the input is no TransferMessage with content
+int TransferMessageContentField(byte_span_t Input);
+
+// Package fields of a Trend or TimeSignal message. Messages too large for one transfer are split into
+// number_of_packages messages with the same uuid, each carrying a part of the binary data (see package_reassembly.h).
+struct package_t
+{
+  envelope_t envelope;
+  byte_span_t uuid;               // trend_uuid or timesignal_uuid
+  Int32_t number_of_packages;     // 0 or 1 if the message is not split
+  Int32_t package_number;
+  byte_span_t binary_data;        // Part of the binary data in this package
+};
+
+// Reads the package fields of a TransferMessage or a bare Trend/TimeSignal message. Returns false for raw binary data
+// and anything else that is not such a message.
+bool FindTrendPackage(byte_span_t Input, package_t &rPackage);
+bool FindTimesignalPackage(byte_span_t Input, package_t &rPackage);
+
+decode_result_t DecodeTrend(byte_span_t Input, decode_buffer_t &rBuffer, trend_view_t &rView);
+decode_result_t DecodeTimesignal(byte_span_t Input, decode_buffer_t &rBuffer, timesignal_view_t &rView);
+
+// Time signals can be too large to inflate at once. DecodeTimesignalHeader does everything DecodeTimesignal does except
+// providing the samples (p_samples stays NULL), StreamTimesignalSamples then hands them out in blocks of at most
+// BlockSize bytes as they are inflated, so the memory needed is independent of the number of samples. With an inflate
+// backend faster than zlib, signals of up to 64 MiB are inflated in one go and then handed out in blocks.
+// SampleCount whole samples starting at sample number FirstSample are passed per call, pSamples is suitably aligned.
+typedef std::function<void(const void *pSamples, size_t FirstSample, size_t SampleCount)> sample_block_function_t;
+
+decode_result_t DecodeTimesignalHeader(byte_span_t Input, timesignal_view_t &rView);
+decode_result_t StreamTimesignalSamples(const timesignal_view_t &rView, decode_buffer_t &rBuffer, size_t BlockSize,
+                                        const sample_block_function_t &rBlock);
+decode_result_t DecodeClassification(byte_span_t Input, decode_buffer_t &rBuffer, classification_view_t &rView);
+
+// For catalogs of many files: locate the binary data and check the header (version, size, checksum, sample type and
+// that the data array has the size the header gives) like the Decode* functions, but do not read the data array at all,
+// neither for its checksum nor to inflate it. rView.data is set, the entries, samples and values are not.
+decode_result_t DecodeTrendHeaderOnly(byte_span_t Input, trend_view_t &rView);
+decode_result_t DecodeTimesignalHeaderOnly(byte_span_t Input, timesignal_view_t &rView);
+decode_result_t DecodeClassificationHeaderOnly(byte_span_t Input, classification_view_t &rView);
@@ -0,0 +1,29 @@
+# Copyright 2025 Schaeffler Monitoring Services GmbH
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+# documentation files(the Software), to deal in the Software without restriction, including without limitation the 
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to 
+# permit persons to whom the Software is furnished to do so, subject to the following conditions :
+#
+# The above copyright notice and this permission notice shall be included in all copies or substantial portions of the 
+# Software.
+#
+# THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE 
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR 
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+# OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+# Optional dependencies of the decoder library, included by every Makefile that builds or links it.
+# libdeflate is used as inflate backend if its header is installed. Build with LIBDEFLATE=0 to use zlib only.
+
+ifndef LIBDEFLATE
+LIBDEFLATE := $(shell printf '\043include <libdeflate.h>\n' | $(CXX) -E -x c++ - >/dev/null 2>&1 && echo 1 || echo 0)
+export LIBDEFLATE
+endif
+
+DECODER_CXX_FLAGS :=
+DECODER_LD_FLAGS  :=
+ifeq ($(LIBDEFLATE),1)
+DECODER_CXX_FLAGS += -DUSE_LIBDEFLATE
+DECODER_LD_FLAGS  += -ldeflate
+endif
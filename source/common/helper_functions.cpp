@@ -17,99 +17,252 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <cstdlib>
-#include <sys/stat.h>
-#include <fcntl.h>
+#include <string.h>
+#include "timestamp_format.h"
 #include "version.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HEX_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef _MSC_VER
-#include <io.h>
-#define read _read
-#define open _open
 #pragma comment(lib, "Ws2_32.lib")
-#else
-#include <unistd.h>
 #endif
 #include <iostream>
 
-#ifndef O_BINARY
-#define O_BINARY 0
+// Value of a hex digit, 0xFF for every other character
+static Uint8_t HexValue(Uint8_t Character)
+{
+    if (Character >= '0' && Character <= '9') return Character - '0';
+    if (Character >= 'a' && Character <= 'f') return Character - 'a' + 10;
+    if (Character >= 'A' && Character <= 'F') return Character - 'A' + 10;
+    return 0xFF;
+}
+
+// 1 for a lower and 2 for an upper case hex digit, 0 for a decimal digit
+static int LetterCase(Uint8_t Character)
+{
+    return Character >= 'a' ? 1 : (Character >= 'A' ? 2 : 0);
+}
+
+#ifdef HEX_SSE2
+// Validates and decodes 16 hex digits, returns false if one of them is no hex digit. rLetterCase collects
+// 1 for lower and 2 for upper case letters.
+static inline bool DecodeHex16(__m128i Characters, __m128i& rValues, int& rLetterCase)
+{
+    __m128i lower = _mm_or_si128(Characters, _mm_set1_epi8(0x20));
+    __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(Characters, _mm_set1_epi8('0' - 1)),
+                                     _mm_cmplt_epi8(Characters, _mm_set1_epi8('9' + 1)));
+    __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                      _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF)
+    {
+        return false;
+    }
+    __m128i is_lower = _mm_cmpeq_epi8(Characters, lower);
+    rLetterCase |= (_mm_movemask_epi8(_mm_and_si128(is_lower, is_letter)) ? 1 : 0)
+                   | (_mm_movemask_epi8(_mm_andnot_si128(is_lower, is_letter)) ? 2 : 0);
+
+    __m128i values = _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(Characters, _mm_set1_epi8('0'))),
+                                  _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    // Each 16 bit lane holds high nibble (low byte) and low nibble (high byte) of one output byte
+    rValues = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 4),
+                           _mm_srli_epi16(values, 8));
+    return true;
+}
+#endif
+
+// Decodes NumPairs pairs of hex digits in place. Returns the number of pairs decoded, less than NumPairs if a
+// character is no hex digit.
+static size_t DecodeHex(Uint8_t* pData, size_t NumPairs, int& rLetterCase)
+{
+    size_t i = 0;
+#ifdef HEX_SSE2
+    // 32 digits per round. Both loads happen before the store, which only overwrites digits already read.
+    for (; i + 16 <= NumPairs; i += 16)
+    {
+        __m128i low_values, high_values;
+        __m128i low = _mm_loadu_si128((const __m128i*) (pData + 2 * i));
+        __m128i high = _mm_loadu_si128((const __m128i*) (pData + 2 * i + 16));
+        if (!DecodeHex16(low, low_values, rLetterCase) || !DecodeHex16(high, high_values, rLetterCase))
+        {
+            break;
+        }
+        _mm_storeu_si128((__m128i*) (pData + i), _mm_packus_epi16(low_values, high_values));
+    }
 #endif
+    for (; i < NumPairs; i++)
+    {
+        Uint8_t high = HexValue(pData[2 * i]);
+        Uint8_t low = HexValue(pData[2 * i + 1]);
+        if ((high | low) == 0xFF)
+        {
+            return i;
+        }
+        rLetterCase |= LetterCase(pData[2 * i]) | LetterCase(pData[2 * i + 1]);
+        pData[i] = (Uint8_t) ((high << 4) | low);
+    }
+    return i;
+}
 
 // Data from OPC/UA via the UA-Expert is given as hex, otherwise as int's. If in hex, it is converted here. Can be removed, if data is provided directly in int.
-void ConvertHexToBinIfNeeded(int buffer_length, char* pBuffer)
+size_t ConvertHexToBinIfNeeded(size_t buffer_length, char* pBuffer)
 {
-    bool is_hex = true;
+    Uint8_t* p_data = (Uint8_t*) pBuffer;
 
-    for (int i = 0; i < (buffer_length / 2 * 2); i++)
+    // Hex copied out of a tool usually ends with a line break
+    size_t hex_length = buffer_length;
+    while (hex_length > 0 && isspace(p_data[hex_length - 1]))
     {
-        if (!isxdigit(pBuffer[i]))
+        hex_length--;
+    }
+    size_t num_pairs = hex_length / 2;
+
+    // Binary input fails within the first bytes, so it is detected before anything is overwritten
+    size_t probe_length = num_pairs * 2 < 64 ? num_pairs * 2 : 64;
+    for (size_t i = 0; i < probe_length; i++)
+    {
+        if (HexValue(p_data[i]) == 0xFF)
         {
-            is_hex = false;
+            return buffer_length;
         }
     }
 
-    if (is_hex)
+    int letter_case = 0;
+    size_t decoded = DecodeHex(p_data, num_pairs, letter_case);
+    if (decoded < num_pairs)
     {
-        for (int i = 0; i < buffer_length / 2; i++)
+        // Not hex after all: encode the bytes decoded so far again, back to front so nothing unread is overwritten.
+        // This restores the input exactly unless it mixed lower and upper case letters.
+        const char* p_digits = (letter_case & 2) ? "0123456789ABCDEF" : "0123456789abcdef";
+        for (size_t i = decoded; i-- > 0;)
         {
-            int tmp = 0;
-            sscanf(pBuffer + i * 2, "%02x", &tmp);
-            pBuffer[i] = tmp & 0xFF;
+            Uint8_t value = p_data[i];
+            p_data[2 * i] = p_digits[value >> 4];
+            p_data[2 * i + 1] = p_digits[value & 0x0F];
         }
-        buffer_length /= 2;
+        return buffer_length;
     }
+    return num_pairs;
 }
 
-int CheckCommandLineParameters(int argc, char** argv, const char* input_data_type, FILE*& outstream)
+void CheckCommandLineParameters(int argc, char** argv, const char* input_data_type, output_writer_t& output)
 {
     if (argc != 2 && argc != 3)
     {
+        fprintf(stderr, "Usage: %s <%s input file> [output file]\n", argv[0], input_data_type);
+        fprintf(stderr, "       %s --batch <output directory> [--jobs <threads>] <input file | directory | pattern> ...\n",
+                argv[0]);
+        fprintf(stderr, "       %s --batch <output directory> [--jobs <threads>] --list <file with input paths, - for stdin>\n",
+                argv[0]);
+        exit(-1);
+    }
+    std::string message;
+    if (argc == 2)
+    {
+        output.OpenStdout();
+    }
+    else if (!output.Open(argv[2], message))
+    {
+        fprintf(stderr, "Error: %s: %s\n", argv[0], message.c_str());
         fprintf(stderr, "Usage: %s <%s input file> [output file]\n", argv[0], input_data_type);
         exit(-1);
     }
-    if (argc == 3)
+}
+
+bool TakeOption(int& argc, char** argv, const char* option)
+{
+    for (int i = 1; i < argc; i++)
     {
-        outstream = fopen(argv[2], "w");
-        if (outstream == NULL)
+        if (strcmp(argv[i], option) == 0)
         {
-            fprintf(stderr, "Error: %s: Could not open output file %s\n", argv[0], argv[2]);
-            fprintf(stderr, "Usage: %s <%s input file> [output file]\n", argv[0], input_data_type);
-            exit(-1);
+            memmove(argv + i, argv + i + 1, (argc - i) * sizeof(char*));
+            argc--;
+            return true;
         }
     }
-    struct stat f_stat;
+    return false;
+}
 
-    if (stat(argv[1], &f_stat) != 0)
+const char* TakeOptionValue(int& argc, char** argv, const char* prefix)
+{
+    size_t prefix_length = strlen(prefix);
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Error: Could not determine size of file %s\n", argv[1]);
-        exit(-1);
+        if (strncmp(argv[i], prefix, prefix_length) == 0)
+        {
+            const char* value = argv[i] + prefix_length;
+            memmove(argv + i, argv + i + 1, (argc - i) * sizeof(char*));
+            argc--;
+            return value;
+        }
     }
-
-    return f_stat.st_size;
+    return NULL;
 }
 
-char* ReadInputFileIntoBuffer(const char* input_file, int buffer_length)
+void ReadInputFile(const char* input_file, input_file_t& rInput)
 {
-    int fh = open(input_file, O_RDONLY | O_BINARY);
-    if (fh < 0)
+    std::string message;
+    if (!rInput.Open(input_file, message))
     {
-        fprintf(stderr, "Error: Could not open file %s\n", input_file);
+        fprintf(stderr, "Error: %s %s\n", message.c_str(), input_file);
         exit(-1);
     }
+}
 
-    char* buffer = new char[buffer_length];
 
-    if (read(fh, buffer, buffer_length) != (int)buffer_length)
+void CloseOutput(output_writer_t& output)
+{
+    std::string message;
+    if (!output.Close(message))
     {
-        fprintf(stderr, "Error: Could not read %d bytes from file into buffer %s\n", (int)buffer_length, input_file);
+        fprintf(stderr, "Error: %s\n", message.c_str());
         exit(-1);
     }
+}
+
+void PrintVersionNumber(FILE *pFile)
+{
+    fprintf(pFile, "%s, version %s\n", program_name.c_str(), version_number.c_str());
+}
 
-    return buffer;
+const char* TimestampAsYYYYMMDDHHMMSSms(timestamp_t Timestamp)
+{
+    static thread_local timestamp_formatter_t formatter;
+    static thread_local char buf[max_timestamp_length];
+
+    *formatter.Format(buf, Timestamp) = 0;
+    return buf;
 }
 
+std::string UuidAsString(const uuid_t Uuid)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X", Uuid[0], Uuid[1],
+             Uuid[2], Uuid[3], Uuid[4], Uuid[5], Uuid[6], Uuid[7], Uuid[8], Uuid[9], Uuid[10], Uuid[11], Uuid[12],
+             Uuid[13], Uuid[14], Uuid[15]);
+    return buf;
+}
 
-void PrintVersionNumber()
+bool UuidFromString(const char* pText, uuid_t Uuid)
 {
-    fprintf(stdout, "%s, version %s\n", program_name.c_str(), version_number.c_str());
-}
\ No newline at end of file
+    size_t digits = 0;
+    for (; *pText; ++pText)
+    {
+        if (*pText == '-')
+        {
+            continue;
+        }
+        int value = *pText >= '0' && *pText <= '9' ? *pText - '0'
+                    : *pText >= 'a' && *pText <= 'f' ? *pText - 'a' + 10
+                    : *pText >= 'A' && *pText <= 'F' ? *pText - 'A' + 10 : -1;
+        if (value < 0 || digits >= 2 * sizeof(uuid_t))
+        {
+            return false;
+        }
+        Uuid[digits / 2] = (unsigned char) (digits % 2 == 0 ? value << 4 : Uuid[digits / 2] | value);
+        ++digits;
+    }
+    return digits == 2 * sizeof(uuid_t);
+}
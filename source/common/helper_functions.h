@@ -16,12 +16,39 @@
 #pragma once
 
 #include <cstdio>
+#include <string>
+#include "datatypes.h"
+#include "input_file.h"
+#include "output_writer.h"
 
 // Data from OPC/UA via the UA-Expert is given as hex, otherwise as int's. If in hex, it is converted here. Can be removed, if data is provided directly in int.
-void ConvertHexToBinIfNeeded(int buffer_length, char* pBuffer);
+// Returns the length of the converted data, buffer_length if the data is not hex.
+size_t ConvertHexToBinIfNeeded(size_t buffer_length, char* pBuffer);
 
-int CheckCommandLineParameters(int argc, char** argv, const char* input_data_type, FILE*& outstream);
+// Opens the output file given as second parameter, or stdout if there is none. Exits with the usage on error.
+void CheckCommandLineParameters(int argc, char** argv, const char* input_data_type, output_writer_t& output);
 
-char* ReadInputFileIntoBuffer(const char* input_file, int buffer_length);
+// Removes the option from the command line if it is given anywhere, so that the positional parameters stay in place.
+// Returns true if it was given.
+bool TakeOption(int& argc, char** argv, const char* option);
 
-void PrintVersionNumber();
\ No newline at end of file
+// Same for options with a value, e.g. TakeOptionValue(argc, argv, "--format=") for "--format=npy". Returns the value,
+// NULL if the option is not given.
+const char* TakeOptionValue(int& argc, char** argv, const char* prefix);
+
+// Maps the input file (or reads it if it is a pipe or "-" for stdin), exits with an error message on failure
+void ReadInputFile(const char* input_file, input_file_t& rInput);
+
+// Flushes and closes the output, exits with an error message if it could not be written completely
+void CloseOutput(output_writer_t& output);
+
+// Stream mode prints it to stderr, stdout then only carries the converted output
+void PrintVersionNumber(FILE *pFile = stdout);
+
+// Formats a timestamp in microseconds as "YYYY-MM-DD HH:MM:SS.mmm (UTC)", "-" if not set. Returns a thread local buffer,
+// timestamp_formatter_t (timestamp_format.h) writes into the caller's buffer instead.
+const char* TimestampAsYYYYMMDDHHMMSSms(timestamp_t Timestamp);
+// Formats a uuid as "00112233-4455-6677-8899-AABBCCDDEEFF", the way the converters print it
+std::string UuidAsString(const uuid_t Uuid);
+// Reads a uuid written like UuidAsString prints it, the dashes are optional. Returns false if it is no uuid.
+bool UuidFromString(const char* pText, uuid_t Uuid);
@@ -0,0 +1,172 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "input_file.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#define read _read
+#define open _open
+#define close _close
+#define fstat _fstat64
+#define stat _stat64
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+// Size of the steps the read buffer grows by when the size of the input is not known
+static const size_t read_chunk_size = 1 << 20;
+
+input_file_t::~input_file_t()
+{
+  Close();
+}
+
+void input_file_t::Close()
+{
+  if (p_mapping)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(p_mapping);
+    CloseHandle((HANDLE) h_mapping);
+    h_mapping = nullptr;
+#else
+    munmap(p_mapping, mapping_size);
+#endif
+    p_mapping = nullptr;
+    mapping_size = 0;
+  }
+  p_data = nullptr;
+  size = 0;
+}
+
+bool input_file_t::ReadAll(int FileHandle, std::string &rMessage)
+{
+  size_t length = 0;
+  for (;;)
+  {
+    size_t capacity = read_buffer.capacity;
+    if (length + read_chunk_size > capacity)
+    {
+      capacity = capacity * 2 > length + read_chunk_size ? capacity * 2 : length + read_chunk_size;
+    }
+    if (read_buffer.Reserve(capacity) == NULL)
+    {
+      rMessage = "Not enough memory to read file";
+      return false;
+    }
+    // read() takes an unsigned int count on Windows, the chunks stay far below that
+    int bytes_read = (int) read(FileHandle, read_buffer.p_data + length, (unsigned) read_chunk_size);
+    if (bytes_read < 0)
+    {
+      rMessage = "Could not read file";
+      return false;
+    }
+    if (bytes_read == 0)
+    {
+      break;
+    }
+    length += (size_t) bytes_read;
+  }
+  p_data = read_buffer.p_data;
+  size = length;
+  return true;
+}
+
+bool input_file_t::Open(const char *pFileName, std::string &rMessage, bool ReadAhead)
+{
+  Close();
+
+  bool is_stdin = strcmp(pFileName, "-") == 0;
+#ifdef _WIN32
+  if (is_stdin)
+  {
+    _setmode(0, _O_BINARY);
+  }
+#endif
+  int fh = is_stdin ? 0 : open(pFileName, O_RDONLY | O_BINARY);
+  if (fh < 0)
+  {
+    rMessage = "Could not open file";
+    return false;
+  }
+
+  struct stat f_stat;
+  if (fstat(fh, &f_stat) != 0)
+  {
+    rMessage = "Could not determine size of file";
+    if (!is_stdin)
+    {
+      close(fh);
+    }
+    return false;
+  }
+
+  bool success = true;
+  if ((f_stat.st_mode & S_IFMT) != S_IFREG)
+  {
+    success = ReadAll(fh, rMessage);
+  }
+  else if (f_stat.st_size > 0)
+  {
+    size_t file_size = (size_t) f_stat.st_size;
+#ifdef _WIN32
+    HANDLE h_file = (HANDLE) _get_osfhandle(fh);
+    h_mapping = CreateFileMappingA(h_file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    p_mapping = h_mapping ? MapViewOfFile((HANDLE) h_mapping, FILE_MAP_COPY, 0, 0, 0) : NULL;
+    if (p_mapping == NULL && h_mapping)
+    {
+      CloseHandle((HANDLE) h_mapping);
+      h_mapping = nullptr;
+    }
+#else
+    p_mapping = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fh, 0);
+    if (p_mapping == MAP_FAILED)
+    {
+      p_mapping = nullptr;
+    }
+    else
+    {
+      (void) madvise(p_mapping, file_size, ReadAhead ? MADV_SEQUENTIAL : MADV_RANDOM);
+    }
+#endif
+    if (p_mapping)
+    {
+      mapping_size = file_size;
+      p_data = (Uint8_t*) p_mapping;
+      size = file_size;
+    }
+    else
+    {
+      // Some file systems can not be mapped
+      success = ReadAll(fh, rMessage);
+    }
+  }
+
+  if (!is_stdin)
+  {
+    close(fh);
+  }
+  return success;
+}
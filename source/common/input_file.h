@@ -0,0 +1,56 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Input file source of the converters. Regular files are mapped into memory, so the raw bytes are only held once by the
+ page cache and even files above 2 GiB need no heap copy. Pipes, FIFOs and "-" (stdin) are read into a heap buffer
+ instead. The mapping is private and writable, ConvertHexToBinIfNeeded can convert hex input in place without
+ changing the file.
+ */
+
+#pragma once
+
+#include <string>
+#include "decoder.h"
+
+struct input_file_t
+{
+  Uint8_t *p_data = nullptr;
+  size_t size = 0;
+
+  input_file_t() = default;
+  input_file_t(const input_file_t&) = delete;
+  input_file_t& operator=(const input_file_t&) = delete;
+  ~input_file_t();
+
+  // Maps or reads the whole file, a previously opened file is closed first. Returns false and sets rMessage on error.
+  // Callers that only look at a few bytes of a mapped file (e.g. the headers) pass false for ReadAhead, so that only
+  // the touched pages are read from the disk.
+  bool Open(const char *pFileName, std::string &rMessage, bool ReadAhead = true);
+  // Unmaps the file. The read buffer is kept, so reusing the object for many files does not reallocate.
+  void Close();
+
+  byte_span_t Span() const { return byte_span_t { p_data, size }; }
+
+private:
+  void *p_mapping = nullptr;
+  size_t mapping_size = 0;
+#ifdef _WIN32
+  void *h_mapping = nullptr;
+#endif
+  decode_buffer_t read_buffer;
+
+  bool ReadAll(int FileHandle, std::string &rMessage);
+};
@@ -0,0 +1,217 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "json_writer.h"
+#include <string.h>
+#include <charconv>
+#include "number_format.h"
+
+// Longest shortest round trip representation of a double, e.g. "-2.2250738585072014e-308"
+static const size_t max_json_number_length = 32;
+
+// Input bytes escaped per Reserve, each one needs at most 6 output bytes ("\u001f")
+static const size_t escape_chunk_size = 1024;
+
+void json_uuid_t::Set(const uuid_t Uuid)
+{
+  static const char hex_digits[] = "0123456789ABCDEF";
+  char *p = text;
+  *p++ = '"';
+  for (int i = 0; i < 16; ++i)
+  {
+    if (i == 4 || i == 6 || i == 8 || i == 10)
+    {
+      *p++ = '-';
+    }
+    *p++ = hex_digits[Uuid[i] >> 4];
+    *p++ = hex_digits[Uuid[i] & 0x0F];
+  }
+  *p++ = '"';
+  length = (size_t) (p - text);
+}
+
+void json_uuid_t::Set(const char *pBytes, size_t Length)
+{
+  if (Length == sizeof(uuid_t))
+  {
+    Set((const unsigned char*) pBytes);
+  }
+  else
+  {
+    memcpy(text, "null", 4);
+    length = 4;
+  }
+}
+
+char* json_writer_t::Key(const char *pKey, size_t Length)
+{
+  size_t key_length = pKey != NULL ? strlen(pKey) : 0;
+  char *p = r_output.Reserve(key_length + Length + 4);
+  if (!first)
+  {
+    *p++ = ',';
+  }
+  first = false;
+  if (pKey != NULL)
+  {
+    *p++ = '"';
+    memcpy(p, pKey, key_length);
+    p += key_length;
+    *p++ = '"';
+    *p++ = ':';
+  }
+  return p;
+}
+
+void json_writer_t::BeginLine()
+{
+  char *p = r_output.Reserve(1);
+  *p++ = '{';
+  r_output.Commit(p);
+  first = true;
+}
+
+void json_writer_t::EndLine()
+{
+  char *p = r_output.Reserve(2);
+  *p++ = '}';
+  *p++ = '\n';
+  r_output.Commit(p);
+}
+
+void json_writer_t::Int(const char *pKey, Int64_t Value)
+{
+  char *p = Key(pKey, max_json_number_length);
+  r_output.Commit(FormatInt(p, Value));
+}
+
+void json_writer_t::Uint(const char *pKey, Uint64_t Value)
+{
+  char *p = Key(pKey, max_json_number_length);
+  r_output.Commit(FormatUint(p, Value));
+}
+
+void json_writer_t::Float(const char *pKey, Float32_t Value)
+{
+  char *p = Key(pKey, max_json_number_length);
+  if (Value - Value != 0.0f)
+  {
+    r_output.Commit(AppendLiteral(p, "null"));
+    return;
+  }
+  r_output.Commit(std::to_chars(p, p + max_json_number_length, Value).ptr);
+}
+
+void json_writer_t::Double(const char *pKey, Float64_t Value)
+{
+  char *p = Key(pKey, max_json_number_length);
+  if (Value - Value != 0.0)
+  {
+    r_output.Commit(AppendLiteral(p, "null"));
+    return;
+  }
+  r_output.Commit(std::to_chars(p, p + max_json_number_length, Value).ptr);
+}
+
+void json_writer_t::Bool(const char *pKey, bool Value)
+{
+  char *p = Key(pKey, 5);
+  r_output.Commit(Value ? AppendLiteral(p, "true") : AppendLiteral(p, "false"));
+}
+
+void json_writer_t::Null(const char *pKey)
+{
+  char *p = Key(pKey, 4);
+  r_output.Commit(AppendLiteral(p, "null"));
+}
+
+void json_writer_t::String(const char *pKey, const char *pValue, size_t Length)
+{
+  static const char hex_digits[] = "0123456789abcdef";
+  char *p = Key(pKey, 1);
+  *p++ = '"';
+  r_output.Commit(p);
+
+  while (Length > 0)
+  {
+    size_t chunk = Length < escape_chunk_size ? Length : escape_chunk_size;
+    p = r_output.Reserve(6 * chunk);
+    for (size_t i = 0; i < chunk; ++i)
+    {
+      unsigned char c = (unsigned char) pValue[i];
+      if (c == '"' || c == '\\')
+      {
+        *p++ = '\\';
+        *p++ = (char) c;
+      }
+      else if (c == '\n')
+      {
+        p = AppendLiteral(p, "\\n");
+      }
+      else if (c == '\r')
+      {
+        p = AppendLiteral(p, "\\r");
+      }
+      else if (c == '\t')
+      {
+        p = AppendLiteral(p, "\\t");
+      }
+      else if (c < 0x20)
+      {
+        p = AppendLiteral(p, "\\u00");
+        *p++ = hex_digits[c >> 4];
+        *p++ = hex_digits[c & 0x0F];
+      }
+      else
+      {
+        *p++ = (char) c;
+      }
+    }
+    r_output.Commit(p);
+    pValue += chunk;
+    Length -= chunk;
+  }
+
+  p = r_output.Reserve(1);
+  *p++ = '"';
+  r_output.Commit(p);
+}
+
+void json_writer_t::String(const char *pKey, const char *pValue)
+{
+  String(pKey, pValue, strlen(pValue));
+}
+
+void json_writer_t::Uuid(const char *pKey, const json_uuid_t &rUuid)
+{
+  char *p = Key(pKey, rUuid.length);
+  memcpy(p, rUuid.text, rUuid.length);
+  r_output.Commit(p + rUuid.length);
+}
+
+void json_writer_t::BeginArray(const char *pKey)
+{
+  char *p = Key(pKey, 1);
+  *p++ = '[';
+  r_output.Commit(p);
+  first = true;
+}
+
+void json_writer_t::EndArray()
+{
+  char *p = r_output.Reserve(1);
+  *p++ = ']';
+  r_output.Commit(p);
+  first = false;
+}
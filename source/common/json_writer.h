@@ -0,0 +1,79 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Streaming writer for JSON Lines: one JSON object per line, written member by member straight into the buffer of the
+ output writer with Reserve/Commit. Nothing is allocated per line, so the writer can be used for millions of samples or
+ trend entries. Numbers use the shortest representation that reads back to the same value, nan and inf (which JSON
+ can not express) are written as null.
+
+ The converters repeat the uuid of the message (trend, measurement, classification or device config) in every line, so
+ the lines of many files can be mixed in one log stream and still be told apart.
+
+ Keys are written as given and have to be plain identifiers. String values are escaped; they are expected to be UTF-8
+ like all strings of the SmartCheck protobuf messages.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include "datatypes.h"
+#include "output_writer.h"
+
+// A uuid rendered once as quoted JSON string, so that every line of a file can repeat it with a memcpy
+struct json_uuid_t
+{
+  json_uuid_t() : length(4) { memcpy(text, "null", 4); }
+  explicit json_uuid_t(const uuid_t Uuid) { Set(Uuid); }
+  json_uuid_t(const char *pBytes, size_t Length) { Set(pBytes, Length); }
+
+  void Set(const uuid_t Uuid);
+  // Takes a uuid of the protobuf messages (16 bytes), anything else becomes null
+  void Set(const char *pBytes, size_t Length);
+
+  char text[40];
+  size_t length;
+};
+
+struct json_writer_t
+{
+  explicit json_writer_t(output_writer_t &rOutput) : r_output(rOutput) {}
+
+  // Starts and ends a line with one object
+  void BeginLine();
+  void EndLine();
+
+  // Members of the current object or array. pKey is NULL for the values of an array.
+  void Int(const char *pKey, Int64_t Value);
+  void Uint(const char *pKey, Uint64_t Value);
+  void Float(const char *pKey, Float32_t Value);
+  void Double(const char *pKey, Float64_t Value);
+  void Bool(const char *pKey, bool Value);
+  void Null(const char *pKey);
+  void String(const char *pKey, const char *pValue, size_t Length);
+  void String(const char *pKey, const char *pValue);
+  void Uuid(const char *pKey, const json_uuid_t &rUuid);
+
+  void BeginArray(const char *pKey);
+  void EndArray();
+
+private:
+  output_writer_t &r_output;
+  bool first = true;   // No comma before the next member
+
+  // Reserves room for the key and Length more bytes and writes the comma and the key. The caller writes the value and
+  // commits.
+  char* Key(const char *pKey, size_t Length);
+};
@@ -0,0 +1,36 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "key_value_metadata.h"
+#include <stdio.h>
+
+void key_value_metadata_t::Add(const char *pKey, const std::string &rValue)
+{
+  entries.push_back(std::make_pair(std::string(pKey), rValue));
+}
+
+void key_value_metadata_t::AddInt(const char *pKey, Int64_t Value)
+{
+  char value[32];
+  snprintf(value, sizeof(value), "%lld", (long long) Value);
+  Add(pKey, value);
+}
+
+void key_value_metadata_t::AddFloat(const char *pKey, Float64_t Value, int Digits)
+{
+  char value[64];
+  snprintf(value, sizeof(value), "%.*g", Digits, Value);
+  Add(pKey, value);
+}
@@ -0,0 +1,252 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "message_stream.h"
+#include <fcntl.h>
+#include <string.h>
+#include "helper_functions.h"
+#include "package_reassembly.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#define open _open
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+// Bytes asked for per read, a message that arrived is taken at once whatever its size
+static const size_t stream_read_size = 64 * 1024;
+
+bool message_stream_t::Fill(size_t Length)
+{
+  while (end - begin < Length)
+  {
+    if (at_end)
+    {
+      return false;
+    }
+    // Move the unused bytes to the front and make room for the rest of the message
+    if (begin > 0)
+    {
+      memmove(buffer.p_data, buffer.p_data + begin, end - begin);
+      end -= begin;
+      begin = 0;
+    }
+    size_t capacity = buffer.capacity;
+    if (capacity < Length || capacity - end < stream_read_size)
+    {
+      capacity = end + (Length > stream_read_size ? Length : stream_read_size);
+      capacity = capacity > buffer.capacity * 2 ? capacity : buffer.capacity * 2;
+      if (buffer.Reserve(capacity) == NULL)
+      {
+        error_message = "Not enough memory for message";
+        at_end = true;
+        return false;
+      }
+    }
+    // read() takes an unsigned int count on Windows
+    size_t room = buffer.capacity - end;
+    int bytes_read = (int) read(file_handle, buffer.p_data + end, (unsigned) (room < (1u << 30) ? room : (1u << 30)));
+    if (bytes_read < 0)
+    {
+      error_message = "Could not read stream";
+      at_end = true;
+      return false;
+    }
+    if (bytes_read == 0)
+    {
+      at_end = true;
+    }
+    end += (size_t) bytes_read;
+  }
+  return true;
+}
+
+bool message_stream_t::Next(byte_span_t &rMessage)
+{
+  // Length varint, at most 10 bytes
+  Uint64_t length = 0;
+  size_t length_size = 0;
+  for (;;)
+  {
+    if (!Fill(length_size + 1))
+    {
+      if (length_size > 0 || end > begin)
+      {
+        error_message = "Stream ends inside a message";
+      }
+      return false;
+    }
+    Uint8_t byte = buffer.p_data[begin + length_size];
+    length |= (Uint64_t) (byte & 0x7F) << (7 * length_size);
+    ++length_size;
+    if ((byte & 0x80) == 0)
+    {
+      break;
+    }
+    if (length_size == 10)
+    {
+      error_message = "Invalid message length";
+      return false;
+    }
+  }
+  if (length > max_stream_message_size)
+  {
+    error_message = "Message length " + std::to_string(length) + " too large, the stream is broken";
+    return false;
+  }
+
+  if (!Fill(length_size + (size_t) length))
+  {
+    if (error_message.empty())
+    {
+      error_message = "Stream ends inside a message";
+    }
+    return false;
+  }
+  rMessage = byte_span_t { buffer.p_data + begin + length_size, (size_t) length };
+  begin += length_size + (size_t) length;
+  return true;
+}
+
+bool IsStreamMode(int argc, char **argv)
+{
+  return argc >= 2 && strcmp(argv[1], "--stream") == 0;
+}
+
+int RunStream(int argc, char **argv, transfer_message_field_t TransferMessageField, const convert_function_t &rConvert,
+              find_package_function_t FindPackage)
+{
+  if (argc != 3 && argc != 4)
+  {
+    fprintf(stderr, "Usage: %s --stream <FIFO, pipe or - for stdin> [<output file>]\n", argv[0]);
+    return -1;
+  }
+
+  const char *p_input = argv[2];
+  bool is_stdin = strcmp(p_input, "-") == 0;
+#ifdef _WIN32
+  if (is_stdin)
+  {
+    _setmode(0, _O_BINARY);
+  }
+#endif
+  int file_handle = is_stdin ? 0 : open(p_input, O_RDONLY | O_BINARY);
+  if (file_handle < 0)
+  {
+    fprintf(stderr, "Error: Could not open %s\n", p_input);
+    return -1;
+  }
+
+  static char output_buffer[default_output_buffer_size];
+  output_writer_t output(output_buffer, sizeof(output_buffer));
+  std::string message;
+  if (argc == 4)
+  {
+    if (!output.Open(argv[3], message))
+    {
+      fprintf(stderr, "Error: %s %s\n", message.c_str(), argv[3]);
+      return -1;
+    }
+  }
+  else
+  {
+    output.OpenStdout();
+  }
+
+  message_stream_t stream(file_handle);
+  package_reassembler_t reassembler;
+  Uint64_t num_messages = 0;
+  Uint64_t num_converted = 0;
+  Uint64_t num_skipped = 0;
+  Uint64_t num_failed = 0;
+  byte_span_t record;
+  while (stream.Next(record))
+  {
+    ++num_messages;
+    // TransferMessages with any other content are skipped, bare messages are left to the convert function
+    int content_field = TransferMessageContentField(record);
+    if (content_field != 0 && content_field != TransferMessageField)
+    {
+      ++num_skipped;
+      continue;
+    }
+
+    byte_span_t input = record;
+    package_t package;
+    if (FindPackage != NULL && FindPackage(record, package) && package.number_of_packages > 1)
+    {
+      reassembly_result_t result = reassembler.Add(package, input);
+      if (result == reassembly_duplicate)
+      {
+        ++num_skipped;
+      }
+      else if (result == reassembly_error)
+      {
+        ++num_failed;
+        fprintf(stderr, "Error: Message %llu: package %d of %d does not fit to the others of its message\n",
+                num_messages, package.package_number, package.number_of_packages);
+      }
+      if (result != reassembly_complete)
+      {
+        continue;
+      }
+    }
+
+    message.clear();
+    if (rConvert(input, &output, message))
+    {
+      ++num_converted;
+    }
+    else
+    {
+      ++num_failed;
+      fprintf(stderr, "Error: Message %llu: %s\n", num_messages, message.c_str());
+    }
+    if (!output.Flush())
+    {
+      break;
+    }
+  }
+
+  if (!stream.ErrorMessage().empty())
+  {
+    ++num_failed;
+    fprintf(stderr, "Error: %s after message %llu\n", stream.ErrorMessage().c_str(), num_messages);
+  }
+  reassembler.ForEachPending([&](byte_span_t, int Received, int NumberOfPackages)
+  {
+    ++num_failed;
+    fprintf(stderr, "Error: Split message incomplete, only %d of %d packages received\n", Received, NumberOfPackages);
+  });
+  if (!is_stdin)
+  {
+    close(file_handle);
+  }
+  if (!output.Close(message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return -1;
+  }
+
+  fprintf(stderr, "Stream summary: %llu messages, %llu converted, %llu skipped, %llu failed\n", num_messages,
+          num_converted, num_skipped, num_failed);
+  return num_failed == 0 ? 0 : -1;
+}
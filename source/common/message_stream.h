@@ -0,0 +1,67 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Stream mode shared by the converters: converts a continuous stream of smartcheck::TransferMessage records as they
+ arrive, e.g. from the OPC/UA or message broker bridge, without temporary files.
+
+   <converter> --stream <FIFO, pipe or - for stdin> [<output file>]
+
+ Each record is a varint with the length of the message followed by the message, the framing of
+ writeDelimitedTo / parseDelimitedFrom of the protobuf libraries. TransferMessages with another content than the one of
+ the converter are skipped, bare messages (e.g. a smartcheck::Trend) are converted as well. Every converted message is written out at once, so the output follows the stream. Packages of split
+ trends and time signals are reassembled (see package_reassembly.h).
+ */
+
+#pragma once
+
+#include <string>
+#include "batch.h"
+#include "decoder.h"
+
+// Largest message accepted, a longer length means the stream is broken
+const size_t max_stream_message_size = 1u << 30;
+
+// Reads length delimited messages from a file handle into a buffer that is reused for all messages
+struct message_stream_t
+{
+  explicit message_stream_t(int FileHandle) : file_handle(FileHandle) {}
+  message_stream_t(const message_stream_t&) = delete;
+  message_stream_t& operator=(const message_stream_t&) = delete;
+
+  // Waits for the next message. rMessage stays valid until the next call. Returns false at the end of the stream and
+  // on errors, ErrorMessage then tells which.
+  bool Next(byte_span_t &rMessage);
+  // Empty at the regular end of the stream
+  const std::string& ErrorMessage() const { return error_message; }
+
+private:
+  int file_handle;
+  decode_buffer_t buffer;
+  size_t begin = 0;           // Unused bytes in buffer are begin .. end
+  size_t end = 0;
+  bool at_end = false;
+  std::string error_message;
+
+  // Reads until at least Length unused bytes are in the buffer. Returns false if the stream ends before.
+  bool Fill(size_t Length);
+};
+
+bool IsStreamMode(int argc, char **argv);
+
+// Runs the stream conversion, TransferMessageField selects the records to convert. rConvert is the convert function of
+// the batch mode, it is called with one message at a time. FindPackage enables the reassembly of split messages.
+// Prints errors and a summary to stderr and returns the process exit code.
+int RunStream(int argc, char **argv, transfer_message_field_t TransferMessageField, const convert_function_t &rConvert,
+              find_package_function_t FindPackage = NULL);
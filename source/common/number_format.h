@@ -0,0 +1,84 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Number formatting for the text output without format string parsing. Each function writes at pOut, returns the end of
+ what it wrote and produces exactly the characters of the printf conversion given in its comment. pOut needs room for
+ max_number_length characters (or the width, if larger).
+ */
+
+#pragma once
+
+#include <string.h>
+#include <charconv>
+
+// Longest result: "%f" of -DBL_MAX has 309 integer digits, the point and 6 decimals
+const size_t max_number_length = 330;
+
+// printf itself for nan and inf, whose spelling is platform specific
+char* FormatNonFinite(char *pOut, double Value, int Precision, int Width);
+
+// Right aligns the Length characters at pOut in a field of Width characters
+inline char* PadLeft(char *pOut, size_t Length, int Width)
+{
+  if ((int) Length >= Width)
+  {
+    return pOut + Length;
+  }
+  size_t padding = (size_t) Width - Length;
+  memmove(pOut + padding, pOut, Length);
+  memset(pOut, ' ', padding);
+  return pOut + Width;
+}
+
+// "%*lld"
+inline char* FormatInt(char *pOut, long long Value, int Width = 0)
+{
+  char *p_end = std::to_chars(pOut, pOut + max_number_length, Value).ptr;
+  return PadLeft(pOut, (size_t) (p_end - pOut), Width);
+}
+
+// "%*llu"
+inline char* FormatUint(char *pOut, unsigned long long Value, int Width = 0)
+{
+  char *p_end = std::to_chars(pOut, pOut + max_number_length, Value).ptr;
+  return PadLeft(pOut, (size_t) (p_end - pOut), Width);
+}
+
+// "%*.*f", the default precision of "%f" is 6
+inline char* FormatFixed(char *pOut, double Value, int Precision = 6, int Width = 0)
+{
+  if (Value - Value != 0.0)
+  {
+    return FormatNonFinite(pOut, Value, Precision, Width);
+  }
+  char *p_end = std::to_chars(pOut, pOut + max_number_length, Value, std::chars_format::fixed, Precision).ptr;
+  return PadLeft(pOut, (size_t) (p_end - pOut), Width);
+}
+
+// Copies a string literal without its terminating zero
+template<size_t N>
+inline char* AppendLiteral(char *pOut, const char (&rText)[N])
+{
+  memcpy(pOut, rText, N - 1);
+  return pOut + N - 1;
+}
+
+inline char* AppendString(char *pOut, const char *pText)
+{
+  size_t length = strlen(pText);
+  memcpy(pOut, pText, length);
+  return pOut + length;
+}
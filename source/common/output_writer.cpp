@@ -0,0 +1,252 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "output_writer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+#define open _open
+#define close _close
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+output_writer_t::~output_writer_t()
+{
+  if (owns_file && file_handle >= 0)
+  {
+    close(file_handle);
+  }
+}
+
+bool output_writer_t::Open(const char *pFileName, std::string &rMessage)
+{
+  file_handle = open(pFileName, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY | O_CLOEXEC, 0666);
+  if (file_handle < 0)
+  {
+    rMessage = std::string("Could not open output file ") + pFileName;
+    return false;
+  }
+  owns_file = true;
+  file_name = pFileName;
+  used = 0;
+  written = 0;
+  preallocated = 0;
+  error = 0;
+  return true;
+}
+
+void output_writer_t::OpenStdout()
+{
+  file_handle = fileno(stdout);
+  owns_file = false;
+  file_name = "stdout";
+}
+
+void output_writer_t::Preallocate(Uint64_t Size)
+{
+#if defined(__linux__)
+  Uint64_t end = BytesWritten() + Size;
+  if (owns_file && error == 0 && end > preallocated)
+  {
+    if (posix_fallocate(file_handle, (off_t) preallocated, (off_t) (end - preallocated)) == 0)
+    {
+      preallocated = end;
+    }
+  }
+#else
+  (void) Size;
+#endif
+}
+
+void output_writer_t::WriteOut(const void *pData, size_t Length)
+{
+  if (error != 0)
+  {
+    used = 0;
+    return;
+  }
+  if (!owns_file)
+  {
+    fflush(stdout);
+  }
+
+#ifdef _WIN32
+  const char *p_parts[2] = { p_buffer, (const char*) pData };
+  size_t lengths[2] = { used, Length };
+  for (int i = 0; i < 2 && error == 0; ++i)
+  {
+    while (lengths[i] > 0)
+    {
+      int bytes = _write(file_handle, p_parts[i], (unsigned) (lengths[i] < (1u << 30) ? lengths[i] : (1u << 30)));
+      if (bytes < 0)
+      {
+        error = errno;
+        break;
+      }
+      p_parts[i] += bytes;
+      lengths[i] -= (size_t) bytes;
+      written += (Uint64_t) bytes;
+    }
+  }
+#else
+  struct iovec parts[2];
+  int num_parts = 0;
+  if (used > 0)
+  {
+    parts[num_parts++] = iovec { p_buffer, used };
+  }
+  if (Length > 0)
+  {
+    parts[num_parts++] = iovec { const_cast<void*>(pData), Length };
+  }
+  struct iovec *p_part = parts;
+  while (num_parts > 0)
+  {
+    ssize_t bytes = writev(file_handle, p_part, num_parts);
+    if (bytes < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      error = errno;
+      break;
+    }
+    written += (Uint64_t) bytes;
+    // Skip what was written, a partial write can end anywhere
+    while (num_parts > 0 && (size_t) bytes >= p_part->iov_len)
+    {
+      bytes -= (ssize_t) p_part->iov_len;
+      ++p_part;
+      --num_parts;
+    }
+    if (num_parts > 0)
+    {
+      p_part->iov_base = (char*) p_part->iov_base + bytes;
+      p_part->iov_len -= (size_t) bytes;
+    }
+  }
+#endif
+  used = 0;
+}
+
+void output_writer_t::Write(const void *pData, size_t Length)
+{
+  if (Length <= buffer_size - used)
+  {
+    memcpy(p_buffer + used, pData, Length);
+    used += Length;
+  }
+  else
+  {
+    WriteOut(pData, Length);
+  }
+}
+
+int output_writer_t::VPrintf(const char *pFormat, va_list Args)
+{
+  va_list args;
+  va_copy(args, Args);
+  int length = vsnprintf(p_buffer + used, buffer_size - used, pFormat, args);
+  va_end(args);
+  if (length < 0 || (size_t) length < buffer_size - used)
+  {
+    used += length > 0 ? (size_t) length : 0;
+    return length;
+  }
+
+  WriteOut(NULL, 0);
+  if ((size_t) length < buffer_size)
+  {
+    vsnprintf(p_buffer, buffer_size, pFormat, Args);
+    used = (size_t) length;
+  }
+  else
+  {
+    std::string text((size_t) length + 1, '\0');
+    vsnprintf(&text[0], text.size(), pFormat, Args);
+    WriteOut(text.data(), (size_t) length);
+  }
+  return length;
+}
+
+char* output_writer_t::Reserve(size_t Length)
+{
+  if (Length > buffer_size - used)
+  {
+    WriteOut(NULL, 0);
+  }
+  return p_buffer + used;
+}
+
+bool output_writer_t::Flush()
+{
+  if (used > 0)
+  {
+    WriteOut(NULL, 0);
+  }
+  return error == 0;
+}
+
+bool output_writer_t::Close(std::string &rMessage)
+{
+  Flush();
+  if (owns_file && file_handle >= 0)
+  {
+#ifndef _WIN32
+    if (error == 0 && preallocated > written && ftruncate(file_handle, (off_t) written) != 0)
+    {
+      error = errno;
+    }
+#endif
+    if (close(file_handle) != 0 && error == 0)
+    {
+      error = errno;
+    }
+  }
+  file_handle = -1;
+  owns_file = false;
+  if (error != 0)
+  {
+    rMessage = "Could not write output file " + file_name + ": " + strerror(error);
+    return false;
+  }
+  return true;
+}
+
+int fprintf(output_writer_t *pOutput, const char *pFormat, ...)
+{
+  va_list args;
+  va_start(args, pFormat);
+  int length = pOutput->VPrintf(pFormat, args);
+  va_end(args);
+  return length;
+}
@@ -0,0 +1,94 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Output sink of the converters. Text is collected in a buffer owned by the caller (one per thread, reused for every
+ output file) and written with one system call per buffer; data that does not fit is written together with the buffered
+ text by a single writev. Errors are kept and reported by Close, so a full disk is not silently ignored. Lines can be
+ formatted directly into the buffer with Reserve/Commit, everything else goes through the fprintf overload below, so
+ the converters keep their fprintf(outstream, ...) calls.
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string>
+#include "datatypes.h"
+
+#if defined(__GNUC__)
+#define OUTPUT_PRINTF_FORMAT(FORMAT, ARGS) __attribute__((format(printf, FORMAT, ARGS)))
+#else
+#define OUTPUT_PRINTF_FORMAT(FORMAT, ARGS)
+#endif
+
+// Buffer size the converters use
+const size_t default_output_buffer_size = 1 << 20;
+
+struct output_writer_t
+{
+  output_writer_t(char *pBuffer, size_t BufferSize) : p_buffer(pBuffer), buffer_size(BufferSize) {}
+  output_writer_t(const output_writer_t&) = delete;
+  output_writer_t& operator=(const output_writer_t&) = delete;
+  // Closes a file that was not closed, without reporting errors
+  ~output_writer_t();
+
+  // Creates or truncates the file. Returns false and sets rMessage on error.
+  bool Open(const char *pFileName, std::string &rMessage);
+  // Writes to stdout. Text printed with stdio before is flushed first, so the order is kept.
+  void OpenStdout();
+
+  // Announces that about Size more bytes will be written. A file opened with Open is extended in one step, which
+  // keeps it in few extents; what is not used is cut off by Close. Only a hint, failures are ignored.
+  void Preallocate(Uint64_t Size);
+
+  void Write(const void *pData, size_t Length);
+  int VPrintf(const char *pFormat, va_list Args);
+
+  // Returns room for Length bytes in the buffer (Length must not exceed the buffer size). Commit takes the text
+  // written there up to pEnd.
+  char* Reserve(size_t Length);
+  void Commit(char *pEnd) { used = (size_t) (pEnd - p_buffer); }
+
+  // Name of the file given to Open, "stdout" for OpenStdout
+  const std::string& FileName() const { return file_name; }
+  bool IsFile() const { return owns_file; }
+
+  // Bytes written so far, including the ones still in the buffer
+  Uint64_t BytesWritten() const { return written + used; }
+  bool Failed() const { return error != 0; }
+
+  // Writes the buffer. Returns false if this or an earlier write failed.
+  bool Flush();
+  // Flushes and closes the file. Returns false and sets rMessage if anything could not be written.
+  bool Close(std::string &rMessage);
+
+private:
+  char *p_buffer;
+  size_t buffer_size;
+  size_t used = 0;
+  int file_handle = -1;
+  bool owns_file = false;
+  Uint64_t written = 0;
+  Uint64_t preallocated = 0;   // End of the preallocated part of the file
+  int error = 0;               // errno of the first failed write
+  std::string file_name;
+
+  // Writes the buffer followed by pData
+  void WriteOut(const void *pData, size_t Length);
+};
+
+// printf into an output writer
+int fprintf(output_writer_t *pOutput, const char *pFormat, ...) OUTPUT_PRINTF_FORMAT(2, 3);
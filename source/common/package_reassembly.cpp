@@ -0,0 +1,171 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "package_reassembly.h"
+#include <string.h>
+#include <algorithm>
+
+// Buffers of completed messages kept for reuse
+static const size_t max_free_messages = 4;
+
+void package_reassembler_t::Release(std::unique_ptr<message_t> &rMessage)
+{
+  if (free_messages.size() < max_free_messages && rMessage->data.capacity() <= max_pending_bytes / max_free_messages)
+  {
+    free_messages.push_back(std::move(rMessage));
+  }
+  rMessage.reset();
+}
+
+void package_reassembler_t::DropOldest(const message_t *pKeep)
+{
+  auto oldest = messages.end();
+  for (auto it = messages.begin(); it != messages.end(); ++it)
+  {
+    if (it->second.get() != pKeep && (oldest == messages.end() || it->second->sequence < oldest->second->sequence))
+    {
+      oldest = it;
+    }
+  }
+  if (oldest != messages.end())
+  {
+    pending_bytes -= oldest->second->data.size();
+    ++dropped_messages;
+    Release(oldest->second);
+    messages.erase(oldest);
+  }
+}
+
+reassembly_result_t package_reassembler_t::Add(const package_t &rPackage, byte_span_t &rBinaryData)
+{
+  if (completed)
+  {
+    Release(completed);
+  }
+
+  if (rPackage.number_of_packages <= 1)
+  {
+    rBinaryData = rPackage.binary_data;
+    return reassembly_complete;
+  }
+
+  key.assign((const char*) rPackage.uuid.p_data, rPackage.uuid.size);
+  auto it = messages.find(key);
+  if (it == messages.end())
+  {
+    std::unique_ptr<message_t> p_message;
+    if (free_messages.empty())
+    {
+      p_message.reset(new message_t());
+    }
+    else
+    {
+      p_message = std::move(free_messages.back());
+      free_messages.pop_back();
+    }
+    p_message->uuid = key;
+    p_message->number_of_packages = rPackage.number_of_packages;
+    p_message->sequence = next_sequence++;
+    p_message->parts.clear();
+    p_message->data.clear();
+    it = messages.emplace(key, std::move(p_message)).first;
+  }
+  message_t &r_message = *it->second;
+
+  bool is_duplicate = false;
+  for (const part_t &r_part : r_message.parts)
+  {
+    is_duplicate = is_duplicate || r_part.package_number == rPackage.package_number;
+  }
+  if (is_duplicate)
+  {
+    return reassembly_duplicate;
+  }
+  if (rPackage.number_of_packages != r_message.number_of_packages || rPackage.package_number < 0
+      || rPackage.package_number > rPackage.number_of_packages
+      || r_message.data.size() + rPackage.binary_data.size > max_pending_bytes)
+  {
+    pending_bytes -= r_message.data.size();
+    Release(it->second);
+    messages.erase(it);
+    return reassembly_error;
+  }
+
+  while (pending_bytes + rPackage.binary_data.size > max_pending_bytes)
+  {
+    DropOldest(&r_message);
+  }
+  r_message.parts.push_back(part_t { rPackage.package_number, r_message.data.size(), rPackage.binary_data.size });
+  r_message.data.insert(r_message.data.end(), rPackage.binary_data.p_data,
+                        rPackage.binary_data.p_data + rPackage.binary_data.size);
+  pending_bytes += rPackage.binary_data.size;
+  if ((Int32_t) r_message.parts.size() < r_message.number_of_packages)
+  {
+    return reassembly_pending;
+  }
+
+  // All packages are there: numbered 0 .. n - 1 or 1 .. n, no others
+  completed = std::move(it->second);
+  messages.erase(it);
+  pending_bytes -= completed->data.size();
+  ordered_parts = completed->parts;
+  std::sort(ordered_parts.begin(), ordered_parts.end(), [](const part_t &rA, const part_t &rB)
+  {
+    return rA.package_number < rB.package_number;
+  });
+  if (ordered_parts.back().package_number - ordered_parts.front().package_number != completed->number_of_packages - 1)
+  {
+    return reassembly_error;
+  }
+
+  bool in_order = true;
+  for (size_t i = 0; i < ordered_parts.size(); ++i)
+  {
+    in_order = in_order && ordered_parts[i].offset == completed->parts[i].offset;
+  }
+  if (in_order)
+  {
+    rBinaryData = byte_span_t { completed->data.data(), completed->data.size() };
+    return reassembly_complete;
+  }
+
+  assembled.resize(completed->data.size());
+  size_t offset = 0;
+  for (const part_t &r_part : ordered_parts)
+  {
+    memcpy(assembled.data() + offset, completed->data.data() + r_part.offset, r_part.size);
+    offset += r_part.size;
+  }
+  rBinaryData = byte_span_t { assembled.data(), assembled.size() };
+  return reassembly_complete;
+}
+
+void package_reassembler_t::ForEachPending(
+    const std::function<void(byte_span_t Uuid, int Received, int NumberOfPackages)> &rFunction) const
+{
+  std::vector<const message_t*> pending;
+  for (const auto &r_entry : messages)
+  {
+    pending.push_back(r_entry.second.get());
+  }
+  std::sort(pending.begin(), pending.end(), [](const message_t *pA, const message_t *pB)
+  {
+    return pA->sequence < pB->sequence;
+  });
+  for (const message_t *p_message : pending)
+  {
+    rFunction(byte_span_t { (const Uint8_t*) p_message->uuid.data(), p_message->uuid.size() },
+              (int) p_message->parts.size(), p_message->number_of_packages);
+  }
+}
@@ -0,0 +1,97 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Reassembly of Trend and TimeSignal messages that were split into packages. The packages may come in any order and
+ mixed with packages of other messages, from many files or from one stream. The part of the binary data in each package
+ is appended to the buffer of its message, keyed by the uuid. Once all packages are there, the parts are handed out in
+ package order as one span, which the decoder takes like the binary data of an unsplit message. The buffers of completed
+ messages are reused for the next ones, so nothing is allocated per package once a few messages went through.
+
+ The bytes kept for incomplete messages are limited. A package that would exceed the limit drops the messages that have
+ been waiting longest. The proto does not say whether package_number counts from 0 or 1, both are accepted.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "datatypes.h"
+#include "decoder.h"
+
+enum reassembly_result_t
+{
+  reassembly_complete,    // rBinaryData holds the binary data of the complete message
+  reassembly_pending,     // Kept, packages of the message are missing
+  reassembly_duplicate,   // The package is already there, ignored
+  reassembly_error        // Package does not fit to the others of its message (number of packages, package number) or
+                          // the message exceeds the limit on its own. The message is dropped.
+};
+
+// Default limit for the bytes of incomplete messages
+const size_t default_max_pending_bytes = 256 << 20;
+
+struct package_reassembler_t
+{
+  explicit package_reassembler_t(size_t MaxPendingBytes = default_max_pending_bytes)
+    : max_pending_bytes(MaxPendingBytes) {}
+  package_reassembler_t(const package_reassembler_t&) = delete;
+  package_reassembler_t& operator=(const package_reassembler_t&) = delete;
+
+  // Takes one package. For reassembly_complete rBinaryData is the binary data of the message: the one of rPackage for a
+  // message that is not split, otherwise memory of the reassembler that stays valid until the next call.
+  reassembly_result_t Add(const package_t &rPackage, byte_span_t &rBinaryData);
+
+  size_t PendingMessages() const { return messages.size(); }
+  size_t PendingBytes() const { return pending_bytes; }
+  // Calls rFunction with the uuid, the number of packages received and expected of each incomplete message
+  void ForEachPending(const std::function<void(byte_span_t Uuid, int Received, int NumberOfPackages)> &rFunction) const;
+
+  // Incomplete messages dropped to stay within the limit
+  Uint64_t dropped_messages = 0;
+
+private:
+  struct part_t
+  {
+    Int32_t package_number;
+    size_t offset;                  // In message_t::data
+    size_t size;
+  };
+
+  struct message_t
+  {
+    std::string uuid;
+    Int32_t number_of_packages;
+    Uint64_t sequence;              // Order of the first packages, the lowest is dropped first
+    std::vector<part_t> parts;      // In the order they came
+    std::vector<Uint8_t> data;      // The parts one after the other
+  };
+
+  size_t max_pending_bytes;
+  size_t pending_bytes = 0;
+  Uint64_t next_sequence = 0;
+  std::unordered_map<std::string, std::unique_ptr<message_t> > messages;   // Incomplete messages by uuid
+  std::vector<std::unique_ptr<message_t> > free_messages;                  // Buffers to reuse
+  std::unique_ptr<message_t> completed;   // Message handed out by the last Add
+  std::string key;                        // Uuid of the package, kept to look up without allocating
+  std::vector<part_t> ordered_parts;
+  std::vector<Uint8_t> assembled;         // Parts of the completed message in package order, if they came unordered
+
+  void Release(std::unique_ptr<message_t> &rMessage);
+  void DropOldest(const message_t *pKeep);
+};
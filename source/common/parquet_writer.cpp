@@ -0,0 +1,676 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "parquet_writer.h"
+#include <math.h>
+#include <string.h>
+#include <unordered_map>
+#include <zlib.h>
+#include "version.h"
+
+// Enums of parquet.thrift that are used here
+enum
+{
+  parquet_physical_boolean = 0,
+  parquet_physical_int32 = 1,
+  parquet_physical_int64 = 2,
+  parquet_physical_float = 4,
+  parquet_physical_double = 5,
+  parquet_converted_timestamp_micros = 10,
+  parquet_converted_uint_8 = 11,
+  parquet_required = 0,
+  parquet_encoding_plain = 0,
+  parquet_encoding_rle = 3,
+  parquet_encoding_delta_binary_packed = 5,
+  parquet_encoding_rle_dictionary = 8,
+  parquet_codec_gzip = 2,
+  parquet_page_data = 0,
+  parquet_page_dictionary = 2
+};
+
+static const char parquet_magic[4] = { 'P', 'A', 'R', '1' };
+
+// After the encodings there is little left that higher levels find, they only cost time (2M trend entries: 0.6 s with
+// level 1, 3 s with the default level 6, and the file is even a bit larger)
+static const int parquet_gzip_level = 1;
+
+// Values per block and miniblocks per block of DELTA_BINARY_PACKED
+static const size_t delta_block_size = 128;
+static const size_t delta_miniblock_count = 4;
+static const size_t delta_miniblock_size = delta_block_size / delta_miniblock_count;
+
+static void PutVarint(std::vector<Uint8_t> &rOut, Uint64_t Value)
+{
+  while (Value >= 0x80)
+  {
+    rOut.push_back((Uint8_t) (Value | 0x80));
+    Value >>= 7;
+  }
+  rOut.push_back((Uint8_t) Value);
+}
+
+static Uint64_t ZigZag(Int64_t Value)
+{
+  return ((Uint64_t) Value << 1) ^ (Uint64_t) (Value >> 63);
+}
+
+// Thrift compact protocol, as much as the Parquet metadata needs. Fields are written in the order of their ids.
+class thrift_writer_t
+{
+public:
+  enum
+  {
+    type_bool_true = 1,
+    type_bool_false = 2,
+    type_byte = 3,
+    type_i32 = 5,
+    type_i64 = 6,
+    type_binary = 8,
+    type_list = 9,
+    type_struct = 12
+  };
+
+  explicit thrift_writer_t(std::vector<Uint8_t> &rOut) : r_out(rOut) {}
+
+  void Bool(Int16_t Field, bool Value) { FieldHeader(Field, Value ? type_bool_true : type_bool_false); }
+
+  void Byte(Int16_t Field, Int8_t Value)
+  {
+    FieldHeader(Field, type_byte);
+    r_out.push_back((Uint8_t) Value);
+  }
+
+  void I32(Int16_t Field, Int32_t Value)
+  {
+    FieldHeader(Field, type_i32);
+    PutVarint(r_out, ZigZag(Value));
+  }
+
+  void I64(Int16_t Field, Int64_t Value)
+  {
+    FieldHeader(Field, type_i64);
+    PutVarint(r_out, ZigZag(Value));
+  }
+
+  void Binary(Int16_t Field, const std::string &rValue)
+  {
+    FieldHeader(Field, type_binary);
+    ListBinary(rValue);
+  }
+
+  // The fields of the struct follow, up to EndStruct
+  void BeginStruct(Int16_t Field)
+  {
+    FieldHeader(Field, type_struct);
+    BeginListStruct();
+  }
+
+  void EndStruct()
+  {
+    r_out.push_back(0);
+    last_field = outer_fields.back();
+    outer_fields.pop_back();
+  }
+
+  // Size elements follow: ListI32, ListBinary or BeginListStruct ... EndStruct
+  void BeginList(Int16_t Field, Uint8_t ElementType, size_t Size)
+  {
+    FieldHeader(Field, type_list);
+    if (Size < 15)
+    {
+      r_out.push_back((Uint8_t) ((Size << 4) | ElementType));
+    }
+    else
+    {
+      r_out.push_back((Uint8_t) (0xF0 | ElementType));
+      PutVarint(r_out, Size);
+    }
+  }
+
+  void ListI32(Int32_t Value) { PutVarint(r_out, ZigZag(Value)); }
+
+  void ListBinary(const std::string &rValue)
+  {
+    PutVarint(r_out, rValue.size());
+    r_out.insert(r_out.end(), rValue.begin(), rValue.end());
+  }
+
+  void BeginListStruct()
+  {
+    outer_fields.push_back(last_field);
+    last_field = 0;
+  }
+
+  // Ends the outermost struct
+  void End() { r_out.push_back(0); }
+
+private:
+  void FieldHeader(Int16_t Field, Uint8_t Type)
+  {
+    if (Field > last_field && Field - last_field <= 15)
+    {
+      r_out.push_back((Uint8_t) (((Field - last_field) << 4) | Type));
+    }
+    else
+    {
+      r_out.push_back(Type);
+      PutVarint(r_out, ZigZag(Field));
+    }
+    last_field = Field;
+  }
+
+  std::vector<Uint8_t> &r_out;
+  std::vector<Int16_t> outer_fields;
+  Int16_t last_field = 0;
+};
+
+// Appends Count values with BitWidth bits each, least significant bit first, padded with zeros to PaddedCount values
+template<typename T>
+static void PackBits(const T *pValues, size_t Count, size_t PaddedCount, int BitWidth, std::vector<Uint8_t> &rOut)
+{
+  const size_t start = rOut.size();
+  rOut.resize(start + (PaddedCount * BitWidth + 7) / 8, 0);
+  Uint8_t *p_out = rOut.data() + start;
+  size_t bit = 0;
+  for (size_t i = 0; i < Count; ++i)
+  {
+    Uint64_t value = pValues[i];
+    for (int remaining = BitWidth; remaining > 0;)
+    {
+      const int shift = (int) (bit % 8);
+      const int length = 8 - shift < remaining ? 8 - shift : remaining;
+      p_out[bit / 8] |= (Uint8_t) ((value & ((1u << length) - 1)) << shift);
+      value >>= length;
+      bit += length;
+      remaining -= length;
+    }
+  }
+}
+
+static int BitWidthOf(Uint64_t Value)
+{
+  int width = 0;
+  while (Value)
+  {
+    ++width;
+    Value >>= 1;
+  }
+  return width;
+}
+
+static size_t RunLength(const Uint32_t *pValues, size_t Count, size_t First)
+{
+  size_t end = First + 1;
+  while (end < Count && pValues[end] == pValues[First])
+  {
+    ++end;
+  }
+  return end - First;
+}
+
+// RLE/bit-packed hybrid: runs of at least 8 equal values are stored as value and count, everything in between bit
+// packed in groups of 8
+static void EncodeRleHybrid(const Uint32_t *pValues, size_t Count, int BitWidth, std::vector<Uint8_t> &rOut)
+{
+  const size_t value_bytes = (size_t) (BitWidth + 7) / 8;
+  size_t first = 0;
+  while (first < Count)
+  {
+    size_t run = RunLength(pValues, Count, first);
+    if (run >= 8)
+    {
+      PutVarint(rOut, (Uint64_t) run << 1);
+      for (size_t i = 0; i < value_bytes; ++i)
+      {
+        rOut.push_back((Uint8_t) (pValues[first] >> (8 * i)));
+      }
+      first += run;
+      continue;
+    }
+
+    // Up to the next long run, rounded up to whole groups. What the rounding takes from the next run is packed too, the
+    // last group is padded.
+    size_t end = first + run;
+    while (end < Count && (run = RunLength(pValues, Count, end)) < 8)
+    {
+      end += run;
+    }
+    const size_t groups = (end - first + 7) / 8;
+    const size_t count = groups * 8 < Count - first ? groups * 8 : Count - first;
+    PutVarint(rOut, (groups << 1) | 1);
+    PackBits(pValues + first, count, groups * 8, BitWidth, rOut);
+    first += count;
+  }
+}
+
+static void EncodeDeltaBinaryPacked(const Int64_t *pValues, size_t Count, std::vector<Uint8_t> &rOut)
+{
+  PutVarint(rOut, delta_block_size);
+  PutVarint(rOut, delta_miniblock_count);
+  PutVarint(rOut, Count);
+  PutVarint(rOut, ZigZag(Count > 0 ? pValues[0] : 0));
+
+  // Deltas are taken modulo 2^64, as the readers do
+  Uint64_t deltas[delta_block_size];
+  for (size_t first = 1; first < Count; first += delta_block_size)
+  {
+    const size_t count = Count - first < delta_block_size ? Count - first : delta_block_size;
+    Int64_t min_delta = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      deltas[i] = (Uint64_t) pValues[first + i] - (Uint64_t) pValues[first + i - 1];
+      if (i == 0 || (Int64_t) deltas[i] < min_delta)
+      {
+        min_delta = (Int64_t) deltas[i];
+      }
+    }
+    Uint8_t bit_widths[delta_miniblock_count] = { 0 };
+    for (size_t i = 0; i < count; ++i)
+    {
+      deltas[i] -= (Uint64_t) min_delta;
+      int width = BitWidthOf(deltas[i]);
+      if (width > bit_widths[i / delta_miniblock_size])
+      {
+        bit_widths[i / delta_miniblock_size] = (Uint8_t) width;
+      }
+    }
+
+    PutVarint(rOut, ZigZag(min_delta));
+    rOut.insert(rOut.end(), bit_widths, bit_widths + delta_miniblock_count);
+    // Miniblocks the last block does not need are left out
+    for (size_t start = 0; start < count; start += delta_miniblock_size)
+    {
+      size_t length = count - start < delta_miniblock_size ? count - start : delta_miniblock_size;
+      PackBits(deltas + start, length, delta_miniblock_size, bit_widths[start / delta_miniblock_size], rOut);
+    }
+  }
+}
+
+template<typename T>
+static void AppendPlain(std::vector<Uint8_t> &rOut, T Value)
+{
+  const Uint8_t *p_value = (const Uint8_t*) &Value;
+  rOut.insert(rOut.end(), p_value, p_value + sizeof(T));
+}
+
+// Collects the distinct values (compared bit wise as key_t) into the PLAIN encoded dictionary rPlain and sets
+// rIndexes. Returns the size of the dictionary, 0 if the values do not fit into MaxSize entries.
+template<typename value_t, typename key_t, typename plain_t>
+static size_t BuildDictionary(const value_t *pValues, size_t Count, size_t MaxSize, std::vector<Uint8_t> &rPlain,
+                              std::vector<Uint32_t> &rIndexes)
+{
+  std::unordered_map<key_t, Uint32_t> dictionary;
+  rPlain.clear();
+  rIndexes.resize(Count);
+  key_t last_key = 0;
+  Uint32_t last_index = 0;
+  for (size_t i = 0; i < Count; ++i)
+  {
+    key_t key;
+    memcpy(&key, &pValues[i], sizeof(key));
+    // Trend values tend to repeat, which saves most lookups
+    if (i > 0 && key == last_key)
+    {
+      rIndexes[i] = last_index;
+      continue;
+    }
+    auto inserted = dictionary.emplace(key, (Uint32_t) dictionary.size());
+    if (inserted.second)
+    {
+      if (dictionary.size() > MaxSize)
+      {
+        return 0;
+      }
+      AppendPlain(rPlain, (plain_t) pValues[i]);
+    }
+    last_key = key;
+    last_index = inserted.first->second;
+    rIndexes[i] = last_index;
+  }
+  return dictionary.size();
+}
+
+// Minimum and maximum PLAIN encoded, NaN is left out. Both stay empty if there is no value.
+template<typename value_t, typename plain_t>
+static void FindMinMax(const value_t *pValues, size_t Count, std::string &rMin, std::string &rMax)
+{
+  size_t first = 0;
+  while (first < Count && pValues[first] != pValues[first])
+  {
+    ++first;
+  }
+  rMin.clear();
+  rMax.clear();
+  if (first == Count)
+  {
+    return;
+  }
+  value_t min_value = pValues[first];
+  value_t max_value = pValues[first];
+  for (size_t i = first + 1; i < Count; ++i)
+  {
+    if (pValues[i] < min_value)
+    {
+      min_value = pValues[i];
+    }
+    else if (pValues[i] > max_value)
+    {
+      max_value = pValues[i];
+    }
+  }
+  // The format wants -0.0 as minimum and +0.0 as maximum when the sign of zero is not known
+  if (min_value == 0)
+  {
+    min_value = (value_t) -0.0;
+  }
+  if (max_value == 0)
+  {
+    max_value = 0;
+  }
+  plain_t min_plain = (plain_t) min_value;
+  plain_t max_plain = (plain_t) max_value;
+  rMin.assign((const char*) &min_plain, sizeof(plain_t));
+  rMax.assign((const char*) &max_plain, sizeof(plain_t));
+}
+
+static void CompressGzip(const std::vector<Uint8_t> &rInput, std::vector<Uint8_t> &rOutput)
+{
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  deflateInit2(&stream, parquet_gzip_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  rOutput.resize(deflateBound(&stream, (uLong) rInput.size()));
+  stream.next_in = (Bytef*) rInput.data();
+  stream.avail_in = (uInt) rInput.size();
+  stream.next_out = rOutput.data();
+  stream.avail_out = (uInt) rOutput.size();
+  deflate(&stream, Z_FINISH);
+  rOutput.resize(stream.total_out);
+  deflateEnd(&stream);
+}
+
+void parquet_writer_t::AddColumn(const char *pName, parquet_type_t Type)
+{
+  column_names.push_back(pName);
+  column_types.push_back(Type);
+}
+
+void parquet_writer_t::Start()
+{
+  r_output.Write(parquet_magic, sizeof(parquet_magic));
+}
+
+void parquet_writer_t::WritePage(Int32_t PageType, Int32_t NumValues, Int32_t Encoding, column_chunk_t &rChunk)
+{
+  CompressGzip(page, compressed);
+
+  header.clear();
+  thrift_writer_t thrift(header);
+  thrift.I32(1, PageType);
+  thrift.I32(2, (Int32_t) page.size());
+  thrift.I32(3, (Int32_t) compressed.size());
+  if (PageType == parquet_page_dictionary)
+  {
+    thrift.BeginStruct(7);
+    thrift.I32(1, NumValues);
+    thrift.I32(2, Encoding);
+    thrift.EndStruct();
+  }
+  else
+  {
+    // Required columns have no definition and repetition levels, the encodings have to be given anyway
+    thrift.BeginStruct(5);
+    thrift.I32(1, NumValues);
+    thrift.I32(2, Encoding);
+    thrift.I32(3, parquet_encoding_rle);
+    thrift.I32(4, parquet_encoding_rle);
+    thrift.EndStruct();
+  }
+  thrift.End();
+
+  r_output.Write(header.data(), header.size());
+  r_output.Write(compressed.data(), compressed.size());
+  rChunk.uncompressed_size += (Int64_t) (header.size() + page.size());
+  rChunk.compressed_size += (Int64_t) (header.size() + compressed.size());
+}
+
+void parquet_writer_t::WriteColumnChunk(size_t Column, Int64_t NumRows, const void *pValues, column_chunk_t &rChunk)
+{
+  const size_t count = (size_t) NumRows;
+  const parquet_type_t type = column_types[Column];
+  rChunk.dictionary_page_offset = -1;
+  rChunk.uncompressed_size = 0;
+  rChunk.compressed_size = 0;
+  page.clear();
+
+  if (type == parquet_timestamp_us)
+  {
+    const Int64_t *p_values = (const Int64_t*) pValues;
+    FindMinMax<Int64_t, Int64_t>(p_values, count, rChunk.min_value, rChunk.max_value);
+    EncodeDeltaBinaryPacked(p_values, count, page);
+    rChunk.encodings.assign(1, parquet_encoding_delta_binary_packed);
+    rChunk.data_page_offset = (Int64_t) r_output.BytesWritten();
+    WritePage(parquet_page_data, (Int32_t) count, parquet_encoding_delta_binary_packed, rChunk);
+    return;
+  }
+
+  if (type == parquet_bool)
+  {
+    const Uint8_t *p_values = (const Uint8_t*) pValues;
+    FindMinMax<Uint8_t, Uint8_t>(p_values, count, rChunk.min_value, rChunk.max_value);
+    indexes.assign(p_values, p_values + count);
+    // RLE for data pages is prefixed with its length
+    page.resize(sizeof(Uint32_t));
+    EncodeRleHybrid(indexes.data(), count, 1, page);
+    const Uint32_t length = (Uint32_t) (page.size() - sizeof(Uint32_t));
+    memcpy(page.data(), &length, sizeof(length));
+    rChunk.encodings.assign(1, parquet_encoding_rle);
+    rChunk.data_page_offset = (Int64_t) r_output.BytesWritten();
+    WritePage(parquet_page_data, (Int32_t) count, parquet_encoding_rle, rChunk);
+    return;
+  }
+
+  size_t dictionary_size = 0;
+  switch (type)
+  {
+    case parquet_uint8:
+      FindMinMax<Uint8_t, Int32_t>((const Uint8_t*) pValues, count, rChunk.min_value, rChunk.max_value);
+      dictionary_size = BuildDictionary<Uint8_t, Uint8_t, Int32_t>((const Uint8_t*) pValues, count, 256, page,
+                                                                    indexes);
+      break;
+    case parquet_float32:
+      FindMinMax<Float32_t, Float32_t>((const Float32_t*) pValues, count, rChunk.min_value, rChunk.max_value);
+      dictionary_size = BuildDictionary<Float32_t, Uint32_t, Float32_t>((const Float32_t*) pValues, count,
+                                                                         parquet_max_dictionary_size, page, indexes);
+      break;
+    default:
+      FindMinMax<Float64_t, Float64_t>((const Float64_t*) pValues, count, rChunk.min_value, rChunk.max_value);
+      dictionary_size = BuildDictionary<Float64_t, Uint64_t, Float64_t>((const Float64_t*) pValues, count,
+                                                                         parquet_max_dictionary_size, page, indexes);
+      break;
+  }
+
+  if (dictionary_size == 0)
+  {
+    // Only floats get here, they are stored as they are
+    const size_t value_size = type == parquet_float32 ? sizeof(Float32_t) : sizeof(Float64_t);
+    page.assign((const Uint8_t*) pValues, (const Uint8_t*) pValues + count * value_size);
+    rChunk.encodings.assign(1, parquet_encoding_plain);
+    rChunk.data_page_offset = (Int64_t) r_output.BytesWritten();
+    WritePage(parquet_page_data, (Int32_t) count, parquet_encoding_plain, rChunk);
+    return;
+  }
+
+  rChunk.dictionary_page_offset = (Int64_t) r_output.BytesWritten();
+  WritePage(parquet_page_dictionary, (Int32_t) dictionary_size, parquet_encoding_plain, rChunk);
+  const int bit_width = dictionary_size > 1 ? BitWidthOf(dictionary_size - 1) : 1;
+  page.assign(1, (Uint8_t) bit_width);
+  EncodeRleHybrid(indexes.data(), count, bit_width, page);
+  rChunk.encodings.assign(1, parquet_encoding_plain);
+  rChunk.encodings.push_back(parquet_encoding_rle_dictionary);
+  rChunk.data_page_offset = (Int64_t) r_output.BytesWritten();
+  WritePage(parquet_page_data, (Int32_t) count, parquet_encoding_rle_dictionary, rChunk);
+}
+
+void parquet_writer_t::WriteRowGroup(Int64_t NumRows, const void *const *ppColumns)
+{
+  row_groups.push_back(row_group_t());
+  row_group_t &r_row_group = row_groups.back();
+  r_row_group.num_rows = NumRows;
+  r_row_group.columns.resize(column_types.size());
+  for (size_t i = 0; i < column_types.size(); ++i)
+  {
+    WriteColumnChunk(i, NumRows, ppColumns[i], r_row_group.columns[i]);
+  }
+}
+
+// Parquet type a column is stored as, in the order of parquet_type_t
+static const Int32_t physical_types[] = { parquet_physical_boolean, parquet_physical_int32, parquet_physical_float,
+                                          parquet_physical_double, parquet_physical_int64 };
+
+// Schema element of a column with physical, converted and logical type
+static void WriteSchemaElement(thrift_writer_t &rThrift, const std::string &rName, parquet_type_t Type)
+{
+  rThrift.BeginListStruct();
+  rThrift.I32(1, physical_types[Type]);
+  rThrift.I32(3, parquet_required);
+  rThrift.Binary(4, rName);
+  if (Type == parquet_uint8)
+  {
+    rThrift.I32(6, parquet_converted_uint_8);
+    rThrift.BeginStruct(10);   // LogicalType.INTEGER
+    rThrift.BeginStruct(10);
+    rThrift.Byte(1, 8);
+    rThrift.Bool(2, false);
+    rThrift.EndStruct();
+    rThrift.EndStruct();
+  }
+  else if (Type == parquet_timestamp_us)
+  {
+    rThrift.I32(6, parquet_converted_timestamp_micros);
+    rThrift.BeginStruct(10);   // LogicalType.TIMESTAMP, adjusted to UTC, in microseconds
+    rThrift.BeginStruct(8);
+    rThrift.Bool(1, true);
+    rThrift.BeginStruct(2);
+    rThrift.BeginStruct(2);
+    rThrift.EndStruct();
+    rThrift.EndStruct();
+    rThrift.EndStruct();
+    rThrift.EndStruct();
+  }
+  rThrift.EndStruct();
+}
+
+void parquet_writer_t::Finish()
+{
+  const size_t num_columns = column_types.size();
+  Int64_t num_rows = 0;
+  for (size_t i = 0; i < row_groups.size(); ++i)
+  {
+    num_rows += row_groups[i].num_rows;
+  }
+
+  header.clear();
+  thrift_writer_t thrift(header);
+  thrift.I32(1, 2);
+  thrift.BeginList(2, thrift_writer_t::type_struct, num_columns + 1);
+  thrift.BeginListStruct();
+  thrift.Binary(4, "schema");
+  thrift.I32(5, (Int32_t) num_columns);
+  thrift.EndStruct();
+  for (size_t i = 0; i < num_columns; ++i)
+  {
+    WriteSchemaElement(thrift, column_names[i], column_types[i]);
+  }
+  thrift.I64(3, num_rows);
+
+  thrift.BeginList(4, thrift_writer_t::type_struct, row_groups.size());
+  for (size_t i = 0; i < row_groups.size(); ++i)
+  {
+    const row_group_t &r_row_group = row_groups[i];
+    Int64_t uncompressed_size = 0;
+    Int64_t compressed_size = 0;
+    thrift.BeginListStruct();
+    thrift.BeginList(1, thrift_writer_t::type_struct, num_columns);
+    for (size_t column = 0; column < num_columns; ++column)
+    {
+      const column_chunk_t &r_chunk = r_row_group.columns[column];
+      const Int64_t chunk_offset = r_chunk.dictionary_page_offset >= 0 ? r_chunk.dictionary_page_offset
+                                                                        : r_chunk.data_page_offset;
+      uncompressed_size += r_chunk.uncompressed_size;
+      compressed_size += r_chunk.compressed_size;
+      thrift.BeginListStruct();
+      thrift.I64(2, chunk_offset);
+      thrift.BeginStruct(3);   // ColumnMetaData
+      thrift.I32(1, physical_types[column_types[column]]);
+      thrift.BeginList(2, thrift_writer_t::type_i32, r_chunk.encodings.size());
+      for (size_t encoding = 0; encoding < r_chunk.encodings.size(); ++encoding)
+      {
+        thrift.ListI32(r_chunk.encodings[encoding]);
+      }
+      thrift.BeginList(3, thrift_writer_t::type_binary, 1);
+      thrift.ListBinary(column_names[column]);
+      thrift.I32(4, parquet_codec_gzip);
+      thrift.I64(5, r_row_group.num_rows);
+      thrift.I64(6, r_chunk.uncompressed_size);
+      thrift.I64(7, r_chunk.compressed_size);
+      thrift.I64(9, r_chunk.data_page_offset);
+      if (r_chunk.dictionary_page_offset >= 0)
+      {
+        thrift.I64(11, r_chunk.dictionary_page_offset);
+      }
+      thrift.BeginStruct(12);   // Statistics
+      thrift.I64(3, 0);
+      if (!r_chunk.min_value.empty())
+      {
+        thrift.Binary(5, r_chunk.max_value);
+        thrift.Binary(6, r_chunk.min_value);
+      }
+      thrift.EndStruct();
+      thrift.EndStruct();
+      thrift.EndStruct();
+    }
+    thrift.I64(2, uncompressed_size);
+    thrift.I64(3, r_row_group.num_rows);
+    const column_chunk_t &r_first = r_row_group.columns.front();
+    thrift.I64(5, r_first.dictionary_page_offset >= 0 ? r_first.dictionary_page_offset : r_first.data_page_offset);
+    thrift.I64(6, compressed_size);
+    thrift.EndStruct();
+  }
+
+  thrift.BeginList(5, thrift_writer_t::type_struct, metadata.entries.size());
+  for (size_t i = 0; i < metadata.entries.size(); ++i)
+  {
+    thrift.BeginListStruct();
+    thrift.Binary(1, metadata.entries[i].first);
+    thrift.Binary(2, metadata.entries[i].second);
+    thrift.EndStruct();
+  }
+  thrift.Binary(6, program_name + " version " + version_number);
+  // Column orders are needed for readers to trust min_value and max_value
+  thrift.BeginList(7, thrift_writer_t::type_struct, num_columns);
+  for (size_t i = 0; i < num_columns; ++i)
+  {
+    thrift.BeginListStruct();
+    thrift.BeginStruct(1);   // TYPE_ORDER
+    thrift.EndStruct();
+    thrift.EndStruct();
+  }
+  thrift.End();
+
+  const Uint32_t footer_length = (Uint32_t) header.size();
+  r_output.Write(header.data(), header.size());
+  r_output.Write(&footer_length, sizeof(footer_length));
+  r_output.Write(parquet_magic, sizeof(parquet_magic));
+}
@@ -0,0 +1,96 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Minimal Apache Parquet writer for archiving converted tables. Like arrow_writer.h it covers only flat tables of
+ required (never null) fixed width columns, and writes the Thrift metadata by hand, so it needs no Parquet, Arrow or
+ Thrift library. Each column chunk is one data page (format version 1), compressed with gzip from zlib. The encodings are
+ chosen per column type:
+
+   timestamps  DELTA_BINARY_PACKED, regular intervals shrink to a few bytes per block of 128 values
+   bool        RLE
+   uint8       dictionary (RLE_DICTIONARY) - alarm status and alarm map index have a handful of values
+   float       dictionary while a column chunk has at most parquet_max_dictionary_size distinct values, otherwise PLAIN
+
+ Every column chunk gets min/max statistics, so readers skip row groups outside a time range without reading them.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "datatypes.h"
+#include "key_value_metadata.h"
+#include "output_writer.h"
+
+enum parquet_type_t
+{
+  parquet_bool,           // Values given as one byte each, 0 or 1
+  parquet_uint8,
+  parquet_float32,
+  parquet_float64,
+  parquet_timestamp_us    // Int64 microseconds since 01.01.1970 UTC
+};
+
+// Distinct values up to which a float column chunk is dictionary encoded
+const size_t parquet_max_dictionary_size = 4096;
+
+struct parquet_writer_t
+{
+  explicit parquet_writer_t(output_writer_t &rOutput) : r_output(rOutput) {}
+
+  // Schema, columns and metadata have to be added before Start
+  void AddColumn(const char *pName, parquet_type_t Type);
+  key_value_metadata_t metadata;
+
+  // Writes the magic
+  void Start();
+  // Writes one row group. ppColumns holds NumRows values of each column in the order of AddColumn.
+  void WriteRowGroup(Int64_t NumRows, const void *const *ppColumns);
+  // Writes the footer with the schema and the position of all column chunks
+  void Finish();
+
+private:
+  // What the footer needs to know about a written column chunk
+  struct column_chunk_t
+  {
+    std::vector<Int32_t> encodings;
+    Int64_t data_page_offset;
+    Int64_t dictionary_page_offset;   // -1 without dictionary
+    Int64_t uncompressed_size;        // Including the page headers
+    Int64_t compressed_size;
+    std::string min_value;            // Plain encoded, empty if there are no statistics
+    std::string max_value;
+  };
+  struct row_group_t
+  {
+    Int64_t num_rows;
+    std::vector<column_chunk_t> columns;
+  };
+
+  void WriteColumnChunk(size_t Column, Int64_t NumRows, const void *pValues, column_chunk_t &rChunk);
+  // Compresses the encoded values in page and writes them with the page header
+  void WritePage(Int32_t PageType, Int32_t NumValues, Int32_t Encoding, column_chunk_t &rChunk);
+
+  output_writer_t &r_output;
+  std::vector<std::string> column_names;
+  std::vector<parquet_type_t> column_types;
+  std::vector<row_group_t> row_groups;
+  // Scratch memory reused for every page
+  std::vector<Uint8_t> page;
+  std::vector<Uint8_t> compressed;
+  std::vector<Uint8_t> header;
+  std::vector<Uint32_t> indexes;
+};
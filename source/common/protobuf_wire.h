@@ -0,0 +1,208 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Minimal reader of the protobuf wire format (https://protobuf.dev/programming-guides/encoding/), enough to find the few
+ fields the converters need without libprotobuf and without message objects. Accepts and rejects the same inputs as
+ CodedInputStream with WireFormatLite::SkipField.
+ */
+
+#pragma once
+
+#include "datatypes.h"
+#include "decoder.h"
+
+enum wire_type_t
+{
+  wire_type_varint = 0,
+  wire_type_fixed64 = 1,
+  wire_type_length_delimited = 2,
+  wire_type_start_group = 3,
+  wire_type_end_group = 4,
+  wire_type_fixed32 = 5
+};
+
+// Nesting of groups allowed like the default recursion limit of libprotobuf
+const int max_wire_group_depth = 100;
+
+inline int WireTagFieldNumber(Uint32_t Tag)
+{
+  return (int) (Tag >> 3);
+}
+
+inline wire_type_t WireTagType(Uint32_t Tag)
+{
+  return (wire_type_t) (Tag & 7);
+}
+
+// Reads a varint of at most 10 bytes at rpData and advances rpData. Bits beyond 64 are dropped like libprotobuf does.
+// Returns false if the input ends inside the varint or it is longer than 10 bytes.
+inline bool ReadWireVarint(const Uint8_t *&rpData, const Uint8_t *pEnd, Uint64_t &rValue)
+{
+  Uint64_t value = 0;
+  for (int shift = 0; shift < 70; shift += 7)
+  {
+    if (rpData == pEnd)
+    {
+      return false;
+    }
+    Uint8_t byte = *rpData++;
+    value |= shift < 64 ? (Uint64_t) (byte & 0x7F) << shift : 0;
+    if ((byte & 0x80) == 0)
+    {
+      rValue = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Tags are read like CodedInputStream::ReadTag: a varint of up to 10 bytes of which the low 32 bits are taken. 0 is
+// returned at the end of the input and for a broken tag.
+inline Uint32_t ReadWireTag(const Uint8_t *&rpData, const Uint8_t *pEnd)
+{
+  Uint64_t tag = 0;
+  if (!ReadWireVarint(rpData, pEnd, tag))
+  {
+    return 0;
+  }
+  return (Uint32_t) tag;
+}
+
+// Skips the value of the field with the given tag. A group is skipped up to its end tag, Depth is the nesting of groups.
+inline bool SkipWireField(const Uint8_t *&rpData, const Uint8_t *pEnd, Uint32_t Tag, int Depth = 0)
+{
+  Uint64_t value = 0;
+  if (WireTagFieldNumber(Tag) == 0)
+  {
+    return false;
+  }
+  switch (WireTagType(Tag))
+  {
+    case wire_type_varint:
+      return ReadWireVarint(rpData, pEnd, value);
+    case wire_type_fixed64:
+      if (pEnd - rpData < 8)
+      {
+        return false;
+      }
+      rpData += 8;
+      return true;
+    case wire_type_length_delimited:
+      if (!ReadWireVarint(rpData, pEnd, value) || (value & 0xFFFFFFFF) > (Uint64_t) (pEnd - rpData))
+      {
+        return false;
+      }
+      rpData += value & 0xFFFFFFFF;
+      return true;
+    case wire_type_start_group:
+      if (Depth >= max_wire_group_depth)
+      {
+        return false;
+      }
+      for (;;)
+      {
+        Uint32_t tag = ReadWireTag(rpData, pEnd);
+        if (tag == 0)
+        {
+          return false;
+        }
+        if (WireTagType(tag) == wire_type_end_group)
+        {
+          return WireTagFieldNumber(tag) == WireTagFieldNumber(Tag);
+        }
+        if (!SkipWireField(rpData, pEnd, tag, Depth + 1))
+        {
+          return false;
+        }
+      }
+    case wire_type_fixed32:
+      if (pEnd - rpData < 4)
+      {
+        return false;
+      }
+      rpData += 4;
+      return true;
+    default:
+      // End of a group that was not started, or wire type 6 and 7
+      return false;
+  }
+}
+
+// Walks over the top level fields of a protobuf message without creating a message object. OnField is called with the
+// field number and the value of every length delimited field, OnVarint with the field number and the value of every
+// varint field. The last occurrence of a field wins like in ParseFromArray. Returns false if the input is not a valid
+// protobuf message.
+template<typename FieldCallback, typename VarintCallback>
+bool ScanMessage(byte_span_t Message, FieldCallback OnField, VarintCallback OnVarint)
+{
+  // CodedInputStream takes at most 2 GiB
+  if (Message.size > INT32_MAX)
+  {
+    return false;
+  }
+
+  const Uint8_t *p_data = Message.p_data;
+  const Uint8_t *p_end = Message.p_data + Message.size;
+  for (;;)
+  {
+    Uint32_t tag = ReadWireTag(p_data, p_end);
+    if (tag == 0)
+    {
+      break;
+    }
+    if (WireTagFieldNumber(tag) == 0)
+    {
+      return false;
+    }
+    if (WireTagType(tag) == wire_type_length_delimited)
+    {
+      // Lengths are read as 32 bit like in CodedInputStream::ReadVarint32
+      Uint64_t length = 0;
+      if (!ReadWireVarint(p_data, p_end, length))
+      {
+        return false;
+      }
+      length &= 0xFFFFFFFF;
+      if (length > (Uint64_t) (p_end - p_data))
+      {
+        return false;
+      }
+      OnField(WireTagFieldNumber(tag), byte_span_t { p_data, (size_t) length });
+      p_data += length;
+    }
+    else if (WireTagType(tag) == wire_type_varint)
+    {
+      Uint64_t value = 0;
+      if (!ReadWireVarint(p_data, p_end, value))
+      {
+        return false;
+      }
+      OnVarint(WireTagFieldNumber(tag), value);
+    }
+    else if (!SkipWireField(p_data, p_end, tag))
+    {
+      return false;
+    }
+  }
+
+  // A zero tag in the middle of the message is not valid
+  return p_data == p_end;
+}
+
+template<typename FieldCallback>
+bool ScanMessage(byte_span_t Message, FieldCallback OnField)
+{
+  return ScanMessage(Message, OnField, [](int, Uint64_t) {});
+}
@@ -0,0 +1,152 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sample_export.h"
+#include <stdio.h>
+#include <string.h>
+
+// The header of a .npy file including the magic string is padded to a multiple of this
+static const size_t npy_header_alignment = 64;
+
+const char* NpyDescr(sample_datatype32_t SampleType)
+{
+  switch (SampleType)
+  {
+    case data_int8_t:
+      return "|i1";
+    case data_int16_t:
+      return "<i2";
+    case data_int32_t:
+      return "<i4";
+    case data_int64_t:
+      return "<i8";
+    case data_float32_t:
+      return "<f4";
+    case data_float64_t:
+      return "<f8";
+    case data_uint8_t:
+      return "|u1";
+    case data_uint16_t:
+      return "<u2";
+    case data_uint32_t:
+      return "<u4";
+    case data_uint64_t:
+      return "<u8";
+    default:
+      return NULL;
+  }
+}
+
+void WriteNpyHeader(output_writer_t &rOutput, const char *pDescr, Uint64_t Count)
+{
+  // Magic string, version 1.0, header length, dictionary padded with blanks and terminated by a newline
+  char header[npy_header_alignment * 2];
+  const size_t prefix_length = 10;
+  int dict_length = snprintf(header + prefix_length, sizeof(header) - prefix_length,
+                             "{'descr': '%s', 'fortran_order': False, 'shape': (%llu,), }", pDescr,
+                             (unsigned long long) Count);
+  size_t length = prefix_length + (size_t) dict_length + 1;
+  size_t padded_length = (length + npy_header_alignment - 1) / npy_header_alignment * npy_header_alignment;
+  memset(header + prefix_length + dict_length, ' ', padded_length - prefix_length - (size_t) dict_length - 1);
+  header[padded_length - 1] = '\n';
+
+  const Uint16_t header_length = (Uint16_t) (padded_length - prefix_length);
+  memcpy(header, "\x93NUMPY\x01\x00", 8);
+  header[8] = (char) (header_length & 0xFF);
+  header[9] = (char) (header_length >> 8);
+  rOutput.Write(header, padded_length);
+}
+
+bool WavFormatOfSampleType(sample_datatype32_t SampleType, wav_format_t &rFormat, Uint16_t &rBitsPerSample)
+{
+  switch (SampleType)
+  {
+    case data_uint8_t:   // 8 bit PCM is unsigned
+      rFormat = wav_format_pcm;
+      rBitsPerSample = 8;
+      return true;
+    case data_int16_t:
+      rFormat = wav_format_pcm;
+      rBitsPerSample = 16;
+      return true;
+    case data_int32_t:
+      rFormat = wav_format_pcm;
+      rBitsPerSample = 32;
+      return true;
+    case data_float32_t:
+      rFormat = wav_format_float;
+      rBitsPerSample = 32;
+      return true;
+    case data_float64_t:
+      rFormat = wav_format_float;
+      rBitsPerSample = 64;
+      return true;
+    default:
+      return false;
+  }
+}
+
+static char* PutUint16(char *p, Uint16_t Value)
+{
+  p[0] = (char) (Value & 0xFF);
+  p[1] = (char) (Value >> 8);
+  return p + 2;
+}
+
+static char* PutUint32(char *p, Uint32_t Value)
+{
+  p = PutUint16(p, (Uint16_t) (Value & 0xFFFF));
+  return PutUint16(p, (Uint16_t) (Value >> 16));
+}
+
+bool WriteWavHeader(output_writer_t &rOutput, wav_format_t Format, Uint16_t BitsPerSample, Uint32_t SampleRate,
+                    Uint64_t SampleCount, std::string &rMessage)
+{
+  const Uint16_t block_align = BitsPerSample / 8;
+  const Uint64_t data_size = SampleCount * block_align;
+  // Formats other than PCM have the cbSize field and a fact chunk
+  const bool is_pcm = Format == wav_format_pcm;
+  const Uint32_t fmt_size = is_pcm ? 16 : 18;
+  const Uint32_t header_size = 12 + 8 + fmt_size + (is_pcm ? 0 : 12) + 8;
+  if (data_size + header_size - 8 > 0xFFFFFFFFull)
+  {
+    rMessage = "Too many samples for a WAVE file";
+    return false;
+  }
+
+  char header[64];
+  char *p = header;
+  memcpy(p, "RIFF", 4);
+  p = PutUint32(p + 4, (Uint32_t) (data_size + header_size - 8));
+  memcpy(p, "WAVEfmt ", 8);
+  p = PutUint32(p + 8, fmt_size);
+  p = PutUint16(p, (Uint16_t) Format);
+  p = PutUint16(p, 1);   // Mono
+  p = PutUint32(p, SampleRate);
+  p = PutUint32(p, SampleRate * block_align);
+  p = PutUint16(p, block_align);
+  p = PutUint16(p, BitsPerSample);
+  if (!is_pcm)
+  {
+    p = PutUint16(p, 0);
+    memcpy(p, "fact", 4);
+    p = PutUint32(p + 4, 4);
+    p = PutUint32(p, (Uint32_t) SampleCount);
+  }
+  memcpy(p, "data", 4);
+  p = PutUint32(p + 4, (Uint32_t) data_size);
+  rOutput.Write(header, (size_t) (p - header));
+  return true;
+}
@@ -0,0 +1,47 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Binary sample files for further processing without parsing text: NumPy .npy (format version 1.0, one dimensional,
+ little endian) and RIFF WAVE. Only the headers are written here, the samples follow as they come out of the inflate
+ buffer (raw) or out of ScaleSamples (scaled). Both headers need the number of samples up front, which the time signal
+ header provides, so nothing has to be seeked back and the output can be streamed.
+ */
+
+#pragma once
+
+#include <string>
+#include "datatypes.h"
+#include "output_writer.h"
+
+// .npy type of the samples, e.g. "<i2". NULL for unknown types.
+const char* NpyDescr(sample_datatype32_t SampleType);
+
+// Writes the .npy header of an array of Count values of the type pDescr
+void WriteNpyHeader(output_writer_t &rOutput, const char *pDescr, Uint64_t Count);
+
+enum wav_format_t
+{
+  wav_format_pcm = 1,
+  wav_format_float = 3
+};
+
+// WAVE format the samples can be stored in without conversion. Returns false for the types WAVE has no format for
+// (int8, int64 and unsigned types above 8 bit).
+bool WavFormatOfSampleType(sample_datatype32_t SampleType, wav_format_t &rFormat, Uint16_t &rBitsPerSample);
+
+// Writes the header of a mono WAVE file. Returns false and sets rMessage if the data does not fit the 4 GiB limit.
+bool WriteWavHeader(output_writer_t &rOutput, wav_format_t Format, Uint16_t BitsPerSample, Uint32_t SampleRate,
+                    Uint64_t SampleCount, std::string &rMessage);
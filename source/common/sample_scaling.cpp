@@ -0,0 +1,207 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sample_scaling.h"
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCALE_SSE2
+#include <emmintrin.h>
+#endif
+
+// Samples converted to float at a time through a double buffer on the stack
+static const size_t float_chunk_size = 256;
+
+#ifdef SCALE_SSE2
+// Scales four int32 values and stores them as doubles
+static inline void ScaleInt32x4(__m128i Values, __m128d Offset, __m128d ScalingFactor, Float64_t *pScaled)
+{
+  __m128d low = _mm_cvtepi32_pd(Values);
+  __m128d high = _mm_cvtepi32_pd(_mm_shuffle_epi32(Values, _MM_SHUFFLE(1, 0, 3, 2)));
+  _mm_storeu_pd(pScaled, _mm_mul_pd(_mm_sub_pd(low, Offset), ScalingFactor));
+  _mm_storeu_pd(pScaled + 2, _mm_mul_pd(_mm_sub_pd(high, Offset), ScalingFactor));
+}
+
+// Scales eight int16 values given sign or zero extended to int32 in two halves
+static inline void ScaleInt16x8(__m128i Low, __m128i High, __m128d Offset, __m128d ScalingFactor, Float64_t *pScaled)
+{
+  ScaleInt32x4(Low, Offset, ScalingFactor, pScaled);
+  ScaleInt32x4(High, Offset, ScalingFactor, pScaled + 4);
+}
+
+// The SSE2 kernels return how many samples they did, the rest is left to the scalar loop. Types without a kernel
+// (64 bit integers and uint32, which SSE2 can not convert) take this one.
+template<typename sample_t>
+static inline size_t ScaleSse2(const sample_t*, size_t, __m128d, __m128d, Float64_t*)
+{
+  return 0;
+}
+
+static inline size_t ScaleSse2(const Int8_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  size_t i = 0;
+  for (; i + 16 <= Count; i += 16)
+  {
+    __m128i values = _mm_loadu_si128((const __m128i*) (pSamples + i));
+    __m128i low = _mm_srai_epi16(_mm_unpacklo_epi8(values, values), 8);
+    __m128i high = _mm_srai_epi16(_mm_unpackhi_epi8(values, values), 8);
+    ScaleInt16x8(_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16), _mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16),
+                 Offset, ScalingFactor, pScaled + i);
+    ScaleInt16x8(_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16),
+                 _mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16), Offset, ScalingFactor, pScaled + i + 8);
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Uint8_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= Count; i += 16)
+  {
+    __m128i values = _mm_loadu_si128((const __m128i*) (pSamples + i));
+    __m128i low = _mm_unpacklo_epi8(values, zero);
+    __m128i high = _mm_unpackhi_epi8(values, zero);
+    ScaleInt16x8(_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), Offset, ScalingFactor, pScaled + i);
+    ScaleInt16x8(_mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero), Offset, ScalingFactor,
+                 pScaled + i + 8);
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Int16_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  size_t i = 0;
+  for (; i + 8 <= Count; i += 8)
+  {
+    __m128i values = _mm_loadu_si128((const __m128i*) (pSamples + i));
+    ScaleInt16x8(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16),
+                 _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16), Offset, ScalingFactor, pScaled + i);
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Uint16_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 8 <= Count; i += 8)
+  {
+    __m128i values = _mm_loadu_si128((const __m128i*) (pSamples + i));
+    ScaleInt16x8(_mm_unpacklo_epi16(values, zero), _mm_unpackhi_epi16(values, zero), Offset, ScalingFactor,
+                 pScaled + i);
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Int32_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  size_t i = 0;
+  for (; i + 4 <= Count; i += 4)
+  {
+    ScaleInt32x4(_mm_loadu_si128((const __m128i*) (pSamples + i)), Offset, ScalingFactor, pScaled + i);
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Float32_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  size_t i = 0;
+  for (; i + 4 <= Count; i += 4)
+  {
+    __m128 values = _mm_loadu_ps(pSamples + i);
+    __m128d low = _mm_cvtps_pd(values);
+    __m128d high = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+    _mm_storeu_pd(pScaled + i, _mm_mul_pd(_mm_sub_pd(low, Offset), ScalingFactor));
+    _mm_storeu_pd(pScaled + i + 2, _mm_mul_pd(_mm_sub_pd(high, Offset), ScalingFactor));
+  }
+  return i;
+}
+
+static inline size_t ScaleSse2(const Float64_t *pSamples, size_t Count, __m128d Offset, __m128d ScalingFactor,
+                               Float64_t *pScaled)
+{
+  size_t i = 0;
+  for (; i + 2 <= Count; i += 2)
+  {
+    _mm_storeu_pd(pScaled + i, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(pSamples + i), Offset), ScalingFactor));
+  }
+  return i;
+}
+#endif
+
+template<typename sample_t>
+static void ScaleToDouble(const sample_t *pSamples, size_t Count, Float64_t Offset, Float64_t ScalingFactor,
+                          Float64_t *pScaled)
+{
+  size_t i = 0;
+#ifdef SCALE_SSE2
+  i = ScaleSse2(pSamples, Count, _mm_set1_pd(Offset), _mm_set1_pd(ScalingFactor), pScaled);
+#endif
+  for (; i < Count; ++i)
+  {
+    pScaled[i] = ((Float64_t) pSamples[i] - Offset) * ScalingFactor;
+  }
+}
+
+template<typename sample_t>
+static void ScaleToFloat(const sample_t *pSamples, size_t Count, Float64_t Offset, Float64_t ScalingFactor,
+                         Float32_t *pScaled)
+{
+  Float64_t chunk[float_chunk_size];
+  for (size_t first = 0; first < Count; first += float_chunk_size)
+  {
+    size_t count = Count - first < float_chunk_size ? Count - first : float_chunk_size;
+    ScaleToDouble(pSamples + first, count, Offset, ScalingFactor, chunk);
+    for (size_t i = 0; i < count; ++i)
+    {
+      pScaled[first + i] = (Float32_t) chunk[i];
+    }
+  }
+}
+
+template<typename sample_t, typename scaled_t>
+void ScaleSamples(const sample_t *pSamples, size_t Count, Float64_t Offset, Float64_t ScalingFactor, scaled_t *pScaled)
+{
+  if constexpr (std::is_same<scaled_t, Float32_t>::value)
+  {
+    ScaleToFloat(pSamples, Count, Offset, ScalingFactor, pScaled);
+  }
+  else
+  {
+    ScaleToDouble(pSamples, Count, Offset, ScalingFactor, pScaled);
+  }
+}
+
+#define INSTANTIATE_SCALE_SAMPLES(SAMPLE_TYPE) \
+  template void ScaleSamples(const SAMPLE_TYPE*, size_t, Float64_t, Float64_t, Float64_t*); \
+  template void ScaleSamples(const SAMPLE_TYPE*, size_t, Float64_t, Float64_t, Float32_t*);
+
+INSTANTIATE_SCALE_SAMPLES(Int8_t)
+INSTANTIATE_SCALE_SAMPLES(Int16_t)
+INSTANTIATE_SCALE_SAMPLES(Int32_t)
+INSTANTIATE_SCALE_SAMPLES(Int64_t)
+INSTANTIATE_SCALE_SAMPLES(Float32_t)
+INSTANTIATE_SCALE_SAMPLES(Float64_t)
+INSTANTIATE_SCALE_SAMPLES(Uint8_t)
+INSTANTIATE_SCALE_SAMPLES(Uint16_t)
+INSTANTIATE_SCALE_SAMPLES(Uint32_t)
+INSTANTIATE_SCALE_SAMPLES(Uint64_t)
@@ -0,0 +1,78 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Sample type kernels. DispatchSampleType turns the sample type of a time signal into the C++ type once, so the code
+ that walks the samples is written as one template and instantiated per type. ScaleSamples computes the physical values
+ (sample - offset) * scaling_factor for a block of samples, with SSE2 where the CPU has it. The results are exactly the
+ ones of the plain double expression.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "datatypes.h"
+
+template<typename sample_t>
+struct sample_type_tag_t
+{
+  typedef sample_t type;
+};
+
+// Calls rFunction(sample_type_tag_t<sample_t>()) with the C++ type of SampleType. Returns false for unknown types.
+template<typename function_t>
+inline bool DispatchSampleType(sample_datatype32_t SampleType, function_t &&rFunction)
+{
+  switch (SampleType)
+  {
+    case data_int8_t:
+      rFunction(sample_type_tag_t<Int8_t>());
+      return true;
+    case data_int16_t:
+      rFunction(sample_type_tag_t<Int16_t>());
+      return true;
+    case data_int32_t:
+      rFunction(sample_type_tag_t<Int32_t>());
+      return true;
+    case data_int64_t:
+      rFunction(sample_type_tag_t<Int64_t>());
+      return true;
+    case data_float32_t:
+      rFunction(sample_type_tag_t<Float32_t>());
+      return true;
+    case data_float64_t:
+      rFunction(sample_type_tag_t<Float64_t>());
+      return true;
+    case data_uint8_t:
+      rFunction(sample_type_tag_t<Uint8_t>());
+      return true;
+    case data_uint16_t:
+      rFunction(sample_type_tag_t<Uint16_t>());
+      return true;
+    case data_uint32_t:
+      rFunction(sample_type_tag_t<Uint32_t>());
+      return true;
+    case data_uint64_t:
+      rFunction(sample_type_tag_t<Uint64_t>());
+      return true;
+    default:
+      return false;
+  }
+}
+
+// pScaled[i] = (pSamples[i] - Offset) * ScalingFactor for i < Count. scaled_t is Float64_t, or Float32_t for outputs
+// that store single precision (computed in double and rounded once). Instantiated for all sample types.
+template<typename sample_t, typename scaled_t>
+void ScaleSamples(const sample_t *pSamples, size_t Count, Float64_t Offset, Float64_t ScalingFactor, scaled_t *pScaled);
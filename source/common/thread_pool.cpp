@@ -0,0 +1,124 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "thread_pool.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Queue of one worker. The owner takes from the front, thieves from the back. A task converts at least one file, so a
+// mutex per queue costs nothing compared to the work and keeps this simple.
+struct task_queue_t
+{
+  std::mutex mutex;
+  std::deque<size_t> indexes;
+};
+
+static bool PopFront(task_queue_t &rQueue, size_t &rIndex)
+{
+  std::lock_guard<std::mutex> lock(rQueue.mutex);
+  if (rQueue.indexes.empty())
+  {
+    return false;
+  }
+  rIndex = rQueue.indexes.front();
+  rQueue.indexes.pop_front();
+  return true;
+}
+
+static bool PopBack(task_queue_t &rQueue, size_t &rIndex)
+{
+  std::lock_guard<std::mutex> lock(rQueue.mutex);
+  if (rQueue.indexes.empty())
+  {
+    return false;
+  }
+  rIndex = rQueue.indexes.back();
+  rQueue.indexes.pop_back();
+  return true;
+}
+
+static void RunWorker(unsigned Worker, std::vector<std::unique_ptr<task_queue_t> > &rQueues,
+                      const task_function_t &rTask)
+{
+  const unsigned num_queues = (unsigned) rQueues.size();
+  size_t index = 0;
+  for (;;)
+  {
+    if (PopFront(*rQueues[Worker], index))
+    {
+      rTask(Worker, index);
+      continue;
+    }
+
+    // Own queue is empty: steal, starting with the next worker so that thieves spread over the victims. Tasks are
+    // never added after the start, so once all queues are empty the work is done.
+    bool stolen = false;
+    for (unsigned i = 1; i < num_queues && !stolen; ++i)
+    {
+      stolen = PopBack(*rQueues[(Worker + i) % num_queues], index);
+    }
+    if (!stolen)
+    {
+      return;
+    }
+    rTask(Worker, index);
+  }
+}
+
+unsigned DefaultNumThreads()
+{
+  unsigned num_threads = std::thread::hardware_concurrency();
+  return num_threads > 0 ? num_threads : 1;
+}
+
+void RunWorkStealing(size_t NumTasks, unsigned NumThreads, const task_function_t &rTask)
+{
+  if (NumThreads > NumTasks)
+  {
+    NumThreads = (unsigned) NumTasks;
+  }
+  if (NumThreads <= 1)
+  {
+    for (size_t i = 0; i < NumTasks; ++i)
+    {
+      rTask(0, i);
+    }
+    return;
+  }
+
+  std::vector<std::unique_ptr<task_queue_t> > queues;
+  for (unsigned i = 0; i < NumThreads; ++i)
+  {
+    queues.emplace_back(new task_queue_t());
+  }
+  for (size_t i = 0; i < NumTasks; ++i)
+  {
+    queues[i % NumThreads]->indexes.push_back(i);
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < NumThreads; ++i)
+  {
+    threads.emplace_back(RunWorker, i, std::ref(queues), std::cref(rTask));
+  }
+  RunWorker(0, queues, rTask);
+  for (std::thread &r_thread : threads)
+  {
+    r_thread.join();
+  }
+}
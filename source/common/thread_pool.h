@@ -0,0 +1,31 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+
+// Task(Worker, Index) is called once for every Index of a run. Worker is the number of the calling thread
+// (0..NumThreads-1) and can be used to select per-thread scratch memory.
+typedef std::function<void(unsigned Worker, size_t Index)> task_function_t;
+
+// Number of threads used if none is given: the number of hardware threads, at least 1
+unsigned DefaultNumThreads();
+
+// Runs Task for all indexes 0..NumTasks-1 on NumThreads threads and returns when all are done. The indexes are dealt
+// round robin to per-thread queues in the given order, a thread whose queue runs empty steals from the back of the
+// others. Callers should pass the largest tasks first. With NumThreads <= 1 everything runs on the calling thread.
+void RunWorkStealing(size_t NumTasks, unsigned NumThreads, const task_function_t &rTask);
@@ -0,0 +1,95 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "timestamp_format.h"
+#include <string.h>
+#include "number_format.h"
+
+static const Int64_t seconds_per_day = 86400;
+
+static inline char* AppendTwoDigits(char *pOut, unsigned Value)
+{
+  pOut[0] = (char) ('0' + Value / 10);
+  pOut[1] = (char) ('0' + Value % 10);
+  return pOut + 2;
+}
+
+// Proleptic Gregorian date of a day number counted from 01.01.1970, as gmtime computes it
+static void CivilFromDays(Int64_t Days, Int64_t &rYear, unsigned &rMonth, unsigned &rDay)
+{
+  Days += 719468;
+  const Int64_t era = (Days >= 0 ? Days : Days - 146096) / 146097;
+  const unsigned day_of_era = (unsigned) (Days - era * 146097);
+  const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const unsigned month_from_march = (5 * day_of_year + 2) / 153;
+  rDay = day_of_year - (153 * month_from_march + 2) / 5 + 1;
+  rMonth = month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+  rYear = (Int64_t) year_of_era + era * 400 + (rMonth <= 2 ? 1 : 0);
+}
+
+char* timestamp_formatter_t::Format(char *pOut, timestamp_t Timestamp)
+{
+  if (style == timestamp_raw_microseconds)
+  {
+    return FormatInt(pOut, Timestamp);
+  }
+  if (Timestamp <= 0)
+  {
+    *pOut = '-';
+    return pOut + 1;
+  }
+
+  const Int64_t second = Timestamp / 1000000;
+  if (second != cached_second)
+  {
+    const Int64_t day = second / seconds_per_day;
+    if (day != cached_day)
+    {
+      Int64_t year = 0;
+      unsigned month = 0;
+      unsigned day_of_month = 0;
+      CivilFromDays(day, year, month, day_of_month);
+      char *p = FormatInt(cached_date, year);   // Timestamps are positive, so the year has at least 4 digits
+      *p++ = '-';
+      p = AppendTwoDigits(p, month);
+      *p++ = '-';
+      p = AppendTwoDigits(p, day_of_month);
+      *p++ = ' ';
+      cached_date_length = (size_t) (p - cached_date);
+      cached_day = day;
+    }
+
+    const unsigned second_of_day = (unsigned) (second - cached_day * seconds_per_day);
+    char *p = AppendTwoDigits(cached_time, second_of_day / 3600);
+    *p++ = ':';
+    p = AppendTwoDigits(p, second_of_day / 60 % 60);
+    *p++ = ':';
+    AppendTwoDigits(p, second_of_day % 60);
+    cached_second = second;
+  }
+
+  memcpy(pOut, cached_date, cached_date_length);
+  pOut += cached_date_length;
+  memcpy(pOut, cached_time, sizeof(cached_time));
+  pOut += sizeof(cached_time);
+  *pOut++ = '.';
+
+  // The milliseconds are the last three digits of the microseconds, as they always have been printed
+  const unsigned milliseconds = (unsigned) (Timestamp % 1000);
+  *pOut++ = (char) ('0' + milliseconds / 100);
+  pOut = AppendTwoDigits(pOut, milliseconds % 100);
+  return AppendLiteral(pOut, " (UTC)");
+}
@@ -0,0 +1,50 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*
+ Timestamp column of the text output. A formatter writes into a caller buffer and keeps the text of the last day and
+ second it formatted, so a run of timestamps of the same day (the normal case for trend entries) only formats the time
+ of day, and one of the same second only the milliseconds. No calendar library call and no static buffer is involved,
+ every output or thread uses its own formatter.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "datatypes.h"
+
+enum timestamp_style_t
+{
+  timestamp_calendar,           // "YYYY-MM-DD HH:MM:SS.mmm (UTC)", "-" if not set, as TimestampAsYYYYMMDDHHMMSSms
+  timestamp_raw_microseconds    // The plain number of microseconds since 01.01.1970, without any calendar math
+};
+
+// Longest text of Format including the terminating zero
+const size_t max_timestamp_length = 40;
+
+struct timestamp_formatter_t
+{
+  timestamp_style_t style = timestamp_calendar;
+
+  // Writes the timestamp at pOut and returns the end of the text, which is not zero terminated
+  char* Format(char *pOut, timestamp_t Timestamp);
+
+private:
+  Int64_t cached_day = -1;
+  char cached_date[24];         // "YYYY-MM-DD " of cached_day
+  size_t cached_date_length = 0;
+  Int64_t cached_second = -1;
+  char cached_time[8];          // "HH:MM:SS" of cached_second
+};
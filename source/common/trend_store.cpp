@@ -0,0 +1,334 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "trend_store.h"
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include "decoder.h"
+#include "helper_functions.h"
+
+namespace fs = std::filesystem;
+
+// Data files grow beyond 2 GiB, which fseek can not reach everywhere
+static bool SeekFile(FILE *pFile, Uint64_t Offset)
+{
+#ifdef _WIN32
+  return _fseeki64(pFile, (__int64) Offset, SEEK_SET) == 0;
+#else
+  return fseeko(pFile, (off_t) Offset, SEEK_SET) == 0;
+#endif
+}
+
+std::string TrendSeriesName(const uuid_t Uuid)
+{
+  return UuidAsString(Uuid);
+}
+
+bool trend_series_t::Open(const char *pStore, const uuid_t Uuid, std::string &rMessage)
+{
+  fs::path base = fs::path(pStore) / TrendSeriesName(Uuid);
+  data_file = base.string() + ".tsd";
+  index_file = base.string() + ".tsi";
+  blocks.clear();
+  pending.clear();
+  added_entries = 0;
+  duplicate_entries = 0;
+  modified = false;
+  memset(&index_header, 0, sizeof(index_header));
+  memcpy(index_header.magic, trend_store_magic, sizeof(index_header.magic));
+  index_header.version = trend_store_version;
+  memcpy(index_header.header.uuid_characteristic_value_config, Uuid, sizeof(uuid_t));
+
+  FILE *p_index = fopen(index_file.c_str(), "rb");
+  if (p_index == NULL)
+  {
+    // New series
+    return true;
+  }
+  trend_store_index_header_t header;
+  bool success = fread(&header, sizeof(header), 1, p_index) == 1
+                 && memcmp(header.magic, trend_store_magic, sizeof(header.magic)) == 0
+                 && header.version == trend_store_version;
+  if (success)
+  {
+    blocks.resize(header.block_count);
+    success = blocks.empty()
+              || fread(blocks.data(), sizeof(trend_store_block_t), blocks.size(), p_index) == blocks.size();
+  }
+  fclose(p_index);
+  if (!success)
+  {
+    blocks.clear();
+    rMessage = "Index " + index_file + " is damaged";
+    return false;
+  }
+  index_header = header;
+  return true;
+}
+
+bool trend_series_t::ReadBlock(FILE *pFile, const trend_store_block_t &rBlock, std::vector<trend_entry_t> &rEntries,
+                               std::string &rMessage) const
+{
+  size_t first = rEntries.size();
+  rEntries.resize(first + rBlock.entry_count);
+  if (!SeekFile(pFile, rBlock.offset)
+      || fread(&rEntries[first], sizeof(trend_entry_t), rBlock.entry_count, pFile) != rBlock.entry_count)
+  {
+    rEntries.resize(first);
+    rMessage = "Could not read " + data_file;
+    return false;
+  }
+  return true;
+}
+
+// Sorts the entries by timestamp and drops repeated timestamps, the first one is kept
+static void SortEntries(std::vector<trend_entry_t> &rEntries)
+{
+  std::stable_sort(rEntries.begin(), rEntries.end(), [](const trend_entry_t &rA, const trend_entry_t &rB)
+  {
+    return rA.timestamp < rB.timestamp;
+  });
+  rEntries.erase(std::unique(rEntries.begin(), rEntries.end(), [](const trend_entry_t &rA, const trend_entry_t &rB)
+  {
+    return rA.timestamp == rB.timestamp;
+  }), rEntries.end());
+}
+
+bool trend_series_t::Add(const trend_header_t &rHeader, const trend_entry_t *pEntries, size_t Count,
+                         std::string &rMessage)
+{
+  if (rHeader.last_timestamp >= index_header.header.last_timestamp)
+  {
+    index_header.header = rHeader;
+    modified = true;
+  }
+  pending.insert(pending.end(), pEntries, pEntries + Count);
+  return pending.size() < trend_store_pending_entries || Merge(rMessage);
+}
+
+bool trend_series_t::Merge(std::string &rMessage)
+{
+  if (pending.empty())
+  {
+    return true;
+  }
+  std::vector<trend_entry_t> chunk;
+  chunk.swap(pending);
+  const size_t num_given = chunk.size();
+  SortEntries(chunk);
+  const timestamp_t first_timestamp = chunk.front().timestamp;
+  const timestamp_t last_timestamp = chunk.back().timestamp;
+
+  // Blocks the new entries overlap: from the first that ends at or after the first entry to the last that starts at or
+  // before the last entry. A block before them that is not full is merged as well, so that small chunks appended one
+  // after the other fill the blocks up.
+  size_t begin = std::lower_bound(blocks.begin(), blocks.end(), first_timestamp,
+                                  [](const trend_store_block_t &rBlock, timestamp_t Timestamp)
+  {
+    return rBlock.last_timestamp < Timestamp;
+  }) - blocks.begin();
+  size_t end = std::upper_bound(blocks.begin() + begin, blocks.end(), last_timestamp,
+                                [](timestamp_t Timestamp, const trend_store_block_t &rBlock)
+  {
+    return Timestamp < rBlock.first_timestamp;
+  }) - blocks.begin();
+  if (begin > 0 && begin == end && blocks[begin - 1].entry_count < trend_store_block_entries)
+  {
+    --begin;
+  }
+
+  FILE *p_data = fopen(data_file.c_str(), "r+b");
+  if (p_data == NULL)
+  {
+    std::error_code error;
+    fs::create_directories(fs::path(data_file).parent_path(), error);
+    p_data = fopen(data_file.c_str(), "w+b");
+  }
+  if (p_data == NULL)
+  {
+    rMessage = "Could not open " + data_file;
+    return false;
+  }
+
+  std::vector<trend_entry_t> stored;
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (!ReadBlock(p_data, blocks[i], stored, rMessage))
+    {
+      fclose(p_data);
+      return false;
+    }
+  }
+
+  // Merge, an entry already stored wins over a new one with the same timestamp
+  size_t num_added = 0;
+  std::vector<trend_entry_t> merged;
+  merged.reserve(stored.size() + chunk.size());
+  size_t s = 0;
+  size_t c = 0;
+  while (s < stored.size() || c < chunk.size())
+  {
+    if (c == chunk.size() || (s < stored.size() && stored[s].timestamp <= chunk[c].timestamp))
+    {
+      if (c < chunk.size() && stored[s].timestamp == chunk[c].timestamp)
+      {
+        ++c;
+      }
+      merged.push_back(stored[s++]);
+    }
+    else
+    {
+      merged.push_back(chunk[c++]);
+      ++num_added;
+    }
+  }
+  added_entries += num_added;
+  duplicate_entries += num_given - num_added;
+  if (num_added == 0)
+  {
+    fclose(p_data);
+    return true;
+  }
+
+  // New blocks go behind everything the index refers to, leftovers of an interrupted ingest are overwritten
+  std::vector<trend_store_block_t> new_blocks;
+  Uint64_t offset = index_header.data_size;
+  bool success = SeekFile(p_data, offset);
+  for (size_t first = 0; success && first < merged.size(); first += trend_store_block_entries)
+  {
+    size_t count = std::min(merged.size() - first, (size_t) trend_store_block_entries);
+    success = fwrite(&merged[first], sizeof(trend_entry_t), count, p_data) == count;
+    new_blocks.push_back(trend_store_block_t { merged[first].timestamp, merged[first + count - 1].timestamp, offset,
+                                               (Uint32_t) count, 0 });
+    offset += count * sizeof(trend_entry_t);
+  }
+  success = fclose(p_data) == 0 && success;
+  if (!success)
+  {
+    rMessage = "Could not write " + data_file;
+    return false;
+  }
+
+  blocks.erase(blocks.begin() + begin, blocks.begin() + end);
+  blocks.insert(blocks.begin() + begin, new_blocks.begin(), new_blocks.end());
+  index_header.block_count = (Uint32_t) blocks.size();
+  index_header.entry_count += num_added;
+  index_header.data_size = offset;
+  modified = true;
+  return true;
+}
+
+bool trend_series_t::Save(std::string &rMessage)
+{
+  if (!Merge(rMessage))
+  {
+    return false;
+  }
+  if (!modified)
+  {
+    return true;
+  }
+  std::string temporary_file = index_file + ".tmp";
+  FILE *p_index = fopen(temporary_file.c_str(), "wb");
+  if (p_index == NULL)
+  {
+    rMessage = "Could not create " + temporary_file;
+    return false;
+  }
+  bool success = fwrite(&index_header, sizeof(index_header), 1, p_index) == 1
+                 && (blocks.empty() || fwrite(blocks.data(), sizeof(trend_store_block_t), blocks.size(), p_index)
+                                       == blocks.size());
+  success = fclose(p_index) == 0 && success;
+  std::error_code error;
+  if (success)
+  {
+    fs::rename(temporary_file, index_file, error);
+  }
+  if (!success || error)
+  {
+    remove(temporary_file.c_str());
+    rMessage = "Could not write " + index_file;
+    return false;
+  }
+  modified = false;
+  return true;
+}
+
+bool trend_series_t::Read(timestamp_t From, timestamp_t To, std::vector<trend_entry_t> &rEntries,
+                          std::string &rMessage) const
+{
+  size_t begin = std::lower_bound(blocks.begin(), blocks.end(), From,
+                                  [](const trend_store_block_t &rBlock, timestamp_t Timestamp)
+  {
+    return rBlock.last_timestamp < Timestamp;
+  }) - blocks.begin();
+  if (begin == blocks.size() || blocks[begin].first_timestamp > To)
+  {
+    return true;
+  }
+
+  FILE *p_data = fopen(data_file.c_str(), "rb");
+  if (p_data == NULL)
+  {
+    rMessage = "Could not open " + data_file;
+    return false;
+  }
+  bool success = true;
+  for (size_t i = begin; success && i < blocks.size() && blocks[i].first_timestamp <= To; ++i)
+  {
+    size_t first = rEntries.size();
+    success = ReadBlock(p_data, blocks[i], rEntries, rMessage);
+    if (success && (blocks[i].first_timestamp < From || blocks[i].last_timestamp > To))
+    {
+      // Only the first and the last block are cut
+      rEntries.erase(std::remove_if(rEntries.begin() + first, rEntries.end(), [&](const trend_entry_t &rEntry)
+      {
+        return rEntry.timestamp < From || rEntry.timestamp > To;
+      }), rEntries.end());
+    }
+  }
+  fclose(p_data);
+  return success;
+}
+
+bool MakeTrendBinary(const trend_header_t &rHeader, const std::vector<trend_entry_t> &rEntries,
+                     std::vector<Uint8_t> &rBinary, std::string &rMessage)
+{
+  if (rEntries.size() > trend_binary_max_entries)
+  {
+    rMessage = std::to_string(rEntries.size()) + " entries do not fit into one trend, at most "
+               + std::to_string(trend_binary_max_entries) + " do";
+    return false;
+  }
+  trend_header_t header = rHeader;
+  header.version = TREND_HEADER_VERSION;
+  header.header_size = sizeof(trend_header_t);
+  header.compression = no_compression;
+  memset(header.uuid_trend, 0, sizeof(uuid_t));
+  header.first_timestamp = rEntries.empty() ? 0 : rEntries.front().timestamp;
+  header.last_timestamp = rEntries.empty() ? 0 : rEntries.back().timestamp;
+  header.value_count = (Int32_t) rEntries.size();
+  header.byte_count = (Int32_t) (rEntries.size() * sizeof(trend_entry_t));
+  header.checksum_data = CalcChecksum(rEntries.data(), rEntries.size() * sizeof(trend_entry_t));
+  header.checksum_header = CalcChecksum(&header, sizeof(trend_header_t) - 2);
+
+  rBinary.resize(sizeof(trend_header_t) + rEntries.size() * sizeof(trend_entry_t));
+  memcpy(rBinary.data(), &header, sizeof(trend_header_t));
+  if (!rEntries.empty())
+  {
+    memcpy(rBinary.data() + sizeof(trend_header_t), rEntries.data(), rEntries.size() * sizeof(trend_entry_t));
+  }
+  return true;
+}
@@ -0,0 +1,119 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Trend store: the history of a characteristic value as one series sorted by timestamp, fed with the trend chunks
+ (.sctd) it arrives in. Chunks may overlap and come in any order; entries with a timestamp that is already stored are
+ dropped, so ingesting a chunk twice changes nothing.
+
+ A store is a directory with two files per uuid_characteristic_value_config, named after the uuid:
+   <uuid>.tsd   data, blocks of up to trend_store_block_entries trend_entry_t sorted by timestamp. Only appended to,
+                a block is never changed once written.
+   <uuid>.tsi   index, trend_store_index_header_t followed by the blocks in time order (trend_store_block_t). The
+                blocks do not overlap, so a time range is read by a binary search over the index and reading the
+                blocks it covers, the chunks are never looked at again.
+
+ The entries of the chunks added to a series are collected and merged at once, when the series is saved or when more
+ than trend_store_pending_entries are waiting. They are merged with the blocks they overlap (and the last block before
+ them if that is not full); the merged entries are appended as new blocks and replace the old ones in the index. So
+ a run of small consecutive chunks writes every entry about once, not the growing last block again for each chunk.
+ The index is written to a temporary file and renamed, so an interrupted ingest leaves the previous state. Replaced
+ blocks stay in the data file unused.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "datatypes.h"
+
+const char trend_store_magic[8] = { 'S', 'C', 'T', 'S', 'T', 'O', 'R', 0 };
+const Uint32_t trend_store_version = 1;
+const Uint32_t trend_store_block_entries = 4096;
+// Entries added to a series are merged when this many are waiting (128 MiB)
+const size_t trend_store_pending_entries = 1 << 22;
+// Most entries one trend can hold, its header counts the bytes of the data array in an Int32_t
+const size_t trend_binary_max_entries = INT32_MAX / sizeof(trend_entry_t);
+
+struct trend_store_index_header_t
+{ // Size: 128 byte
+  char magic[8];                // trend_store_magic
+  Uint32_t version;             // trend_store_version
+  Uint32_t block_count;
+  Uint64_t entry_count;
+  Uint64_t data_size;           // Size of the data file this index refers to, the rest is from an interrupted ingest
+  trend_header_t header;        // Header of the latest chunk (unit, alarm levels), value and byte counts not used
+};
+
+struct trend_store_block_t
+{ // Size: 32 byte
+  timestamp_t first_timestamp;
+  timestamp_t last_timestamp;
+  Uint64_t offset;              // Position in the data file
+  Uint32_t entry_count;
+  Uint32_t unused;
+};
+
+// One series of a store
+struct trend_series_t
+{
+  trend_series_t() = default;
+  trend_series_t(const trend_series_t&) = delete;
+  trend_series_t& operator=(const trend_series_t&) = delete;
+
+  // Loads the index of the series of Uuid in the store directory pStore. A series not in the store yet is empty.
+  // Returns false and sets rMessage on error.
+  bool Open(const char *pStore, const uuid_t Uuid, std::string &rMessage);
+
+  // Adds the Count entries of a chunk with the header rHeader. They are merged into the series later (see above), of
+  // entries with the same timestamp the one stored or added first is kept. Returns false and sets rMessage if a merge
+  // fails.
+  bool Add(const trend_header_t &rHeader, const trend_entry_t *pEntries, size_t Count, std::string &rMessage);
+  // Merges the entries that are waiting and writes the index
+  bool Save(std::string &rMessage);
+
+  // Appends the entries with From <= timestamp <= To to rEntries. Entries added but not merged yet are not included.
+  bool Read(timestamp_t From, timestamp_t To, std::vector<trend_entry_t> &rEntries, std::string &rMessage) const;
+
+  const trend_store_index_header_t& IndexHeader() const { return index_header; }
+  const std::vector<trend_store_block_t>& Blocks() const { return blocks; }
+  // Merged entries since Open that were new and that had a timestamp already stored
+  Uint64_t AddedEntries() const { return added_entries; }
+  Uint64_t DuplicateEntries() const { return duplicate_entries; }
+
+private:
+  std::string data_file;
+  std::string index_file;
+  trend_store_index_header_t index_header;
+  std::vector<trend_store_block_t> blocks;
+  bool modified = false;
+  std::vector<trend_entry_t> pending;
+  Uint64_t added_entries = 0;
+  Uint64_t duplicate_entries = 0;
+
+  bool Merge(std::string &rMessage);
+  bool ReadBlock(FILE *pFile, const trend_store_block_t &rBlock, std::vector<trend_entry_t> &rEntries,
+                 std::string &rMessage) const;
+};
+
+// File name of a series without extension, the uuid as UuidAsString prints it
+std::string TrendSeriesName(const uuid_t Uuid);
+
+// Writes the entries as raw trend binary data (header and uncompressed data array), which trend_data_to_ascii reads
+// like any .sctd file. rHeader gives the uuids, unit and alarm levels. Returns false and sets rMessage if the entries
+// are too many for the Int32_t byte_count of the header (trend_binary_max_entries).
+bool MakeTrendBinary(const trend_header_t &rHeader, const std::vector<trend_entry_t> &rEntries,
+                     std::vector<Uint8_t> &rBinary, std::string &rMessage);
@@ -19,11 +19,17 @@
  The attachment is serialized by googles protobuf.
  */
 
+#include <stdlib.h>
 #include <time.h>
-#include <zlib.h>
+#include <atomic>
+#include <cmath>
+#include <new>
+#include "../common/batch.h"
 #include "../common/datatypes.h"
 #include "../common/helper_functions.h"
-#include "TransferMessage.pb.h"
+#include "../common/json_writer.h"
+#include "../common/message_stream.h"
+#include "../common/protobuf_wire.h"
 #include "DeviceConfig.pb.h"
 #include "JobConfig.pb.h"
 
@@ -38,40 +44,73 @@
 #include <arpa/inet.h>
 #endif
 
-static FILE *outstream = stdout;
+static thread_local output_writer_t *outstream = NULL;
 
-const char* TimestampAsYYYYMMDDHHMMSSms(timestamp_t Timestamp)
+// Output format, chosen with --format=
+enum output_format_t
 {
-  static char buf[64];
-  int year = 0;
-  int month = 0;
-  int day = 0;
-  int hour = 0;
-  int minute = 0;
-  int second = 0;
-  struct tm timeStruct;
+  output_text,
+  output_jsonl   // JSON Lines, one object for the device and one per job, characteristic value, measurement and input
+};
 
-  if (!Timestamp)
+static output_format_t output_format = output_text;
+
+// Heap allocations of the current thread. They are only counted in builds with ALLOCATION_STATS defined
+// (make ALLOCATION_STATS=1), which replace the global operator new below; other builds keep the standard allocator.
+// --allocation-stats prints how many allocations converting an input takes, which shows whether the message objects
+// are really reused.
+static std::atomic<Uint64_t> converted_inputs(0);
+static std::atomic<Uint64_t> conversion_allocations(0);
+
+#ifdef ALLOCATION_STATS
+static thread_local Uint64_t thread_allocations = 0;
+
+void* operator new(size_t Size)
+{
+  ++thread_allocations;
+  void *p_memory = malloc(Size > 0 ? Size : 1);
+  if (p_memory == NULL)
   {
-    sprintf(buf, "-");
-    return buf;
+    throw std::bad_alloc();
   }
+  return p_memory;
+}
+
+void* operator new[](size_t Size)
+{
+  return operator new(Size);
+}
 
-  memset(&timeStruct, 0, sizeof(struct tm));
-  const time_t ts = Timestamp / 1000000;
-  int ms = Timestamp % 1000;
-  gmtime_r(&ts, &timeStruct);
+void operator delete(void *pMemory) noexcept
+{
+  free(pMemory);
+}
+
+void operator delete(void *pMemory, size_t) noexcept
+{
+  free(pMemory);
+}
+
+void operator delete[](void *pMemory) noexcept
+{
+  free(pMemory);
+}
 
-  year = timeStruct.tm_year + 1900;
-  month = timeStruct.tm_mon + 1;
-  day = timeStruct.tm_mday;
-  hour = timeStruct.tm_hour;
-  minute = timeStruct.tm_min;
-  second = timeStruct.tm_sec;
+void operator delete[](void *pMemory, size_t) noexcept
+{
+  free(pMemory);
+}
 
-  sprintf(buf, "%04d-%02d-%02d %02d:%02d:%02d.%03d (UTC)", year, month, day, hour, minute, second, ms);
-  return buf;
+static Uint64_t ThreadAllocations()
+{
+  return thread_allocations;
 }
+#else
+static Uint64_t ThreadAllocations()
+{
+  return 0;
+}
+#endif
 
 std::string ExtractTranslateFromName(const std::string &rName)
 {
@@ -97,7 +136,7 @@ std::string ExtractTranslateFromName(const std::string &rName)
 
 const char* PrintBlanks(int NumOfBlanks)
 {
-  static char blank_buffer[64];
+  static thread_local char blank_buffer[64];
   int i = 0;
 
   blank_buffer[0] = '?';
@@ -118,7 +157,7 @@ const char* PrintBlanks(int NumOfBlanks)
 
 char* LongFloatToString(Uint32_t NoDigits, Uint32_t NoDecimals, char Delimiter, Float64_t FloatValue)
 {
-  static char buffer[64];
+  static thread_local char buffer[64];
 
   if (std::isnan(FloatValue))
   {
@@ -153,61 +192,6 @@ char* LongFloatToString(Uint32_t NoDigits, Uint32_t NoDecimals, char Delimiter,
 }
 
 
-Uint16_t CalcChecksum(const void *pData, size_t Length)
-{
-  Uint64_t int_length = Length / sizeof(Uint16_t);
-  const Uint16_t *p_int_data = (Uint16_t*) pData;
-
-  Uint16_t checksum = 0;
-  Uint32_t i = 0;
-  for (i = 0; i < int_length; ++i)
-  {
-    checksum ^= p_int_data[i];
-  }
-
-  if (0 != Length % sizeof(Uint16_t))
-  {
-    Uint16_t temp = 0;
-    memcpy(&temp, &p_int_data[int_length], Length % sizeof(Uint16_t));
-    checksum ^= temp;
-  }
-
-  return (checksum);
-}
-
-int UncompressData(Bytef *pDest, uLongf *pDestLen, const Bytef *pSource, uLong SourceLen, int WindowBits)
-{
-  z_stream stream;
-  int err = 0;
-
-  stream.next_in = (Bytef*) pSource;
-  stream.avail_in = (uInt) SourceLen;
-  /* Check for source > 64K on 16-bit machine: */
-  if ((uLong) stream.avail_in != SourceLen) return Z_BUF_ERROR;
-
-  stream.next_out = pDest;
-  stream.avail_out = (uInt) *pDestLen;
-  if ((uLong) stream.avail_out != *pDestLen) return Z_BUF_ERROR;
-
-  stream.zalloc = (alloc_func) 0;
-  stream.zfree = (free_func) 0;
-
-  err = inflateInit2(&stream, WindowBits);
-  if (err != Z_OK) return err;
-
-  err = inflate(&stream, Z_FINISH);
-  if (err != Z_STREAM_END)
-  {
-    (void) inflateEnd(&stream);
-    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) return Z_DATA_ERROR;
-    return err;
-  }
-  *pDestLen = stream.total_out;
-
-  err = inflateEnd(&stream);
-  return err;
-}
-
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
@@ -485,7 +469,7 @@ const char* ProcessSignalMonitorCalculationTypeEnum2String(const smartcheck::Cal
       break;
 
   }
-  static char string[25];
+  static thread_local char string[25];
   snprintf(string, 25, "Unknown (%d)", (int) calculation_type);
   return string;
 }
@@ -1532,47 +1516,264 @@ void PrintDeviceConfig(const smartcheck::DeviceConfig &rDeviceConfig)
   }
 }
 
-int main(int argc, char **argv)
+static void JsonUuid(json_writer_t &rJson, const char *pKey, const std::string &rUuid)
 {
-  PrintVersionNumber();
- 
-  int buffer_length = CheckCommandLineParameters(argc, argv, "device config", outstream);
+  rJson.Uuid(pKey, json_uuid_t(rUuid.data(), rUuid.size()));
+}
+
+static void JsonIpv4(json_writer_t &rJson, const char *pKey, Uint32_t Address)
+{
+  char text[16];
+  snprintf(text, sizeof(text), "%u.%u.%u.%u", Address & 0xFF, (Address >> 8) & 0xFF, (Address >> 16) & 0xFF,
+           Address >> 24);
+  rJson.String(pKey, text);
+}
+
+// Starts the line of one configuration object with the members all of them have
+template<typename config_t>
+static void BeginJsonConfig(json_writer_t &rJson, const char *pRecord, const json_uuid_t &rDeviceUuid,
+                            const config_t &rConfig)
+{
+  rJson.BeginLine();
+  rJson.String("record", pRecord);
+  rJson.Uuid("device_uuid", rDeviceUuid);
+  JsonUuid(rJson, "current_uuid", rConfig.current_uuid());
+  JsonUuid(rJson, "base_uuid", rConfig.base_uuid());
+  rJson.Int("change_date", rConfig.change_date());
+  rJson.String("name", ExtractTranslateFromName(rConfig.name()).c_str());
+  rJson.Bool("active", rConfig.active());
+}
+
+// Writes the device as first line and one line per job, characteristic value, measurement, input and input channel
+// config with the members of the text output. The parameter blocks below them stay in the text output. Every line
+// carries the device uuid and the indexes of its parents.
+void WriteDeviceConfigJsonl(const smartcheck::DeviceConfig &rDeviceConfig)
+{
+  const json_uuid_t device_uuid(rDeviceConfig.current_uuid().data(), rDeviceConfig.current_uuid().size());
+  json_writer_t json(*outstream);
+
+  json.BeginLine();
+  json.String("record", "device_config");
+  json.Uuid("device_uuid", device_uuid);
+  JsonUuid(json, "base_uuid", rDeviceConfig.base_uuid());
+  json.Int("change_date", rDeviceConfig.change_date());
+  json.String("name", ExtractTranslateFromName(rDeviceConfig.name()).c_str());
+  json.String("device_serial", rDeviceConfig.device_serial().data(), rDeviceConfig.device_serial().size());
+  json.String("firmware_version", rDeviceConfig.firmware_version().data(), rDeviceConfig.firmware_version().size());
+  JsonIpv4(json, "ipv4_addr", ntohl(rDeviceConfig.ipv4_addr()));
+  JsonIpv4(json, "ipv4_netmask", ntohl(rDeviceConfig.ipv4_netmask()));
+  JsonIpv4(json, "ipv4_gateway", ntohl(rDeviceConfig.ipv4_gateway()));
+  JsonIpv4(json, "ipv4_dns", ntohl(rDeviceConfig.ipv4_dns()));
+  json.String("hostname", rDeviceConfig.hostname().data(), rDeviceConfig.hostname().size());
+  json.Int("job_config_count", rDeviceConfig.job_config_size());
+  json.Int("input_config_count", rDeviceConfig.input_config_size());
+  json.EndLine();
+
+  for (int job = 0; job < rDeviceConfig.job_config_size(); ++job)
+  {
+    const smartcheck::JobConfig &r_job_config = rDeviceConfig.job_config(job);
+    BeginJsonConfig(json, "job_config", device_uuid, r_job_config);
+    json.Int("job", job);
+    json.Bool("is_trigger_validator", r_job_config.is_trigger_validator());
+    json.EndLine();
+
+    for (int i = 0; i < r_job_config.characteristic_value_config_size(); ++i)
+    {
+      const smartcheck::CharacteristicValueConfig &r_config = r_job_config.characteristic_value_config(i);
+      BeginJsonConfig(json, "characteristic_value_config", device_uuid, r_config);
+      json.Int("job", job);
+      json.Int("index", i);
+      JsonUuid(json, "template_uuid", r_config.template_uuid());
+      json.Int("type", r_config.type());
+      json.EndLine();
+    }
+
+    for (int i = 0; i < r_job_config.measurement_config_size(); ++i)
+    {
+      const smartcheck::MeasurementConfig &r_config = r_job_config.measurement_config(i);
+      BeginJsonConfig(json, "measurement_config", device_uuid, r_config);
+      json.Int("job", job);
+      json.Int("index", i);
+      JsonUuid(json, "input_channel_uuid", r_config.input_channel_uuid());
+      json.Int("signal_type", r_config.signal_type());
+      json.EndLine();
+    }
+  }
 
-  char* buffer = ReadInputFileIntoBuffer(argv[1], buffer_length);
+  for (int input = 0; input < rDeviceConfig.input_config_size(); ++input)
+  {
+    const smartcheck::InputConfig &r_input_config = rDeviceConfig.input_config(input);
+    BeginJsonConfig(json, "input_config", device_uuid, r_input_config);
+    json.Int("input", input);
+    json.Int("sample_rate", r_input_config.sample_rate());
+    JsonUuid(json, "unit_uuid", r_input_config.unit_uuid());
+    json.String("unit_name", r_input_config.unit_name().data(), r_input_config.unit_name().size());
+    json.String("device_serial", r_input_config.device_serial().data(), r_input_config.device_serial().size());
+    json.String("module_serial", r_input_config.module_serial().data(), r_input_config.module_serial().size());
+    json.Int("channel_index", r_input_config.channel_index());
+    json.EndLine();
 
-  ConvertHexToBinIfNeeded(buffer_length, buffer);
+    for (int i = 0; i < r_input_config.input_channel_config_size(); ++i)
+    {
+      const smartcheck::InputChannelConfig &r_config = r_input_config.input_channel_config(i);
+      BeginJsonConfig(json, "input_channel_config", device_uuid, r_config);
+      json.Int("input", input);
+      json.Int("index", i);
+      json.Double("scaling", r_config.scaling());
+      JsonUuid(json, "unit_uuid", r_config.unit_uuid());
+      json.String("unit_name", r_config.unit_name().data(), r_config.unit_name().size());
+      json.EndLine();
+    }
+  }
+}
 
-  smartcheck::TransferMessage transfer_message;
-  if (transfer_message.ParseFromArray(buffer, buffer_length) && transfer_message.device_config().IsInitialized()
-      && !transfer_message.device_config().current_uuid().empty())
+// Prints the device config as text or writes it in the format chosen with --format=
+void OutputDeviceConfig(const smartcheck::DeviceConfig &rDeviceConfig)
+{
+  if (output_format == output_jsonl)
   {
-    fprintf(stderr, "Device config is in transfer message protobuf format\n");
-    PrintDeviceConfig(transfer_message.device_config());
+    WriteDeviceConfigJsonl(rDeviceConfig);
   }
   else
   {
-    smartcheck::DeviceConfig device_config;
-    if (device_config.ParseFromArray(buffer, buffer_length) && device_config.IsInitialized()
-        && !device_config.current_uuid().empty())
+    PrintDeviceConfig(rDeviceConfig);
+  }
+}
+
+// Parses the device config once. A TransferMessage is not parsed as a whole, only its device_config field, which is
+// found without a message object, so both forms end up in the same DeviceConfig. Returns false if the input is neither
+// or the device config is incomplete.
+static bool ParseDeviceConfig(byte_span_t Input, smartcheck::DeviceConfig &rDeviceConfig, envelope_t &rEnvelope)
+{
+  input_kind_t kind = PeekInputKind(Input);
+  rEnvelope = kind.envelope;
+  byte_span_t message = Input;
+  if (kind.envelope == envelope_transfer_message && kind.transfer_message_field == transfer_message_device_config)
+  {
+    if (!ScanMessage(Input, [&](int FieldNumber, byte_span_t Value)
     {
-      fprintf(stderr, "Device config is in protobuf format\n");
-      PrintDeviceConfig(device_config);
-    }
-    else
+      if (FieldNumber == transfer_message_device_config)
+      {
+        message = Value;
+      }
+    }))
     {
-      fprintf(stderr, "Error: Could parse device config from %s\n", argv[1]);
+      return false;
     }
   }
+  else if (kind.envelope != envelope_protobuf)
+  {
+    return false;
+  }
+  return rDeviceConfig.ParseFromArray(message.p_data, (int) message.size) && rDeviceConfig.IsInitialized()
+         && !rDeviceConfig.current_uuid().empty();
+}
 
-  free(buffer);
+// Convert function of the batch and stream mode, called from several threads
+static bool ConvertDeviceConfig(byte_span_t Input, output_writer_t *pOutstream, std::string &rMessage)
+{
+  // Each thread reuses its own DeviceConfig. ParseFromArray clears it first, which keeps the capacity of its strings and
+  // the objects of its repeated fields (job configs, measurement configs, ...) for the next input, so a parse only
+  // allocates for what the previous inputs did not have. Messages on an arena would be dropped as a whole instead and
+  // every string longer than the small string buffer allocated again.
+  static thread_local smartcheck::DeviceConfig thread_device_config;
+  outstream = pOutstream;
+  Uint64_t allocations = ThreadAllocations();
+  envelope_t envelope = envelope_unknown;
+  if (!ParseDeviceConfig(Input, thread_device_config, envelope))
+  {
+    rMessage = "Could not parse device config";
+    return false;
+  }
+  OutputDeviceConfig(thread_device_config);
+  conversion_allocations += ThreadAllocations() - allocations;
+  ++converted_inputs;
+  return true;
+}
 
-  if (argc == 3)
+static void PrintAllocationStats(bool Print)
+{
+#ifndef ALLOCATION_STATS
+  if (Print)
   {
-      fprintf(stdout, "%s: Success: Device config written to file %s\n", argv[0], argv[2]);
-      fclose(outstream);
+    fprintf(stderr, "Heap allocations are only counted in builds with make ALLOCATION_STATS=1\n");
+    return;
+  }
+#endif
+  if (Print && converted_inputs > 0)
+  {
+    fprintf(stderr, "Heap allocations: %llu for %llu inputs, %.1f per input\n",
+            (unsigned long long) conversion_allocations, (unsigned long long) converted_inputs,
+            (double) conversion_allocations / (double) converted_inputs);
   }
-  exit(0);
 }
 
+int main(int argc, char **argv)
+{
+  bool print_allocation_stats = TakeOption(argc, argv, "--allocation-stats");
+  const char *p_format = TakeOptionValue(argc, argv, "--format=");
+  if (p_format != NULL)
+  {
+    if (strcmp(p_format, "jsonl") == 0)
+    {
+      output_format = output_jsonl;
+    }
+    else if (strcmp(p_format, "text") != 0)
+    {
+      fprintf(stderr, "Error: Unknown output format %s, use text or jsonl\n", p_format);
+      exit(-1);
+    }
+  }
 
+  PrintVersionNumber(IsStreamMode(argc, argv) ? stderr : stdout);
+
+  if (IsStreamMode(argc, argv))
+  {
+    int result = RunStream(argc, argv, transfer_message_device_config, ConvertDeviceConfig);
+    PrintAllocationStats(print_allocation_stats);
+    return result;
+  }
+
+  if (IsBatchMode(argc, argv))
+  {
+    int result = RunBatch(argc, argv, ".scdc", ConvertDeviceConfig, output_format == output_jsonl ? ".jsonl" : ".txt");
+    PrintAllocationStats(print_allocation_stats);
+    return result;
+  }
+
+  static char output_buffer[default_output_buffer_size];
+  output_writer_t output(output_buffer, sizeof(output_buffer));
+  CheckCommandLineParameters(argc, argv, "device config", output);
+  if (output_format != output_text && argc != 3)
+  {
+    fprintf(stderr, "Error: %s: --format=%s needs an output file\n", argv[0], p_format);
+    exit(-1);
+  }
+  outstream = &output;
 
+  input_file_t input;
+  ReadInputFile(argv[1], input);
+
+  input.size = ConvertHexToBinIfNeeded(input.size, (char*) input.p_data);
+
+  smartcheck::DeviceConfig device_config;
+  envelope_t envelope = envelope_unknown;
+  if (ParseDeviceConfig(input.Span(), device_config, envelope))
+  {
+    fprintf(stderr, envelope == envelope_transfer_message ? "Device config is in transfer message protobuf format\n"
+                                                          : "Device config is in protobuf format\n");
+    OutputDeviceConfig(device_config);
+  }
+  else
+  {
+    fprintf(stderr, "Error: Could parse device config from %s\n", argv[1]);
+  }
+
+
+  CloseOutput(output);
+  if (argc == 3)
+  {
+    fprintf(stdout, "%s: Success: Device config written to file %s\n", argv[0], argv[2]);
+  }
+  exit(0);
+}
@@ -0,0 +1,317 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Writes the catalog of an archive (see catalog.h): one record per trend, time signal and classification message with
+ what its header tells, read without inflating or even touching the data arrays.
+
+   smartcheck_catalog <catalog file> [--jobs <threads>] [--packed] <input file | directory | pattern> ...
+   smartcheck_catalog <catalog file> [--jobs <threads>] [--packed] --list <file with input paths, - for stdin>
+
+ The inputs are given like in the batch mode of the converters; directories are walked for .sctd, .scts and .sccd
+ files. With --packed every input is a stream of length delimited messages (as for --stream) and gets a record per
+ message with its offset in the file. The files are only mapped and read where the headers are, so the catalog is
+ limited by the number of files the file system can open rather than by their size.
+
+   smartcheck_catalog --query <catalog file> [--config <uuid>] [--message <uuid>] [--kind <kind>] [--type <type>]
+                      [--from <timestamp>] [--to <timestamp>] [--details]
+
+ Prints the files of the messages that match all given filters, one per line and in time order, to be piped into the
+ batch mode of the converters with --list -. Messages of packed files are printed as "<path>\t<offset>\t<size>".
+ --config takes a uuid_config or uuid_characteristic_value_config, --message a uuid_measurement, uuid_trend or
+ uuid_classification_data, --kind trend, timesignal or classification, --type a signal_type or data_type. Timestamps
+ are microseconds since 01.01.1970; a message matches if its time range overlaps from..to. --details prints the
+ catalog record instead of the path only.
+ */
+
+#include <stdio.h>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "../common/batch.h"
+#include "../common/catalog.h"
+#include "../common/helper_functions.h"
+#include "../common/input_file.h"
+#include "../common/protobuf_wire.h"
+#include "../common/thread_pool.h"
+
+struct catalog_input_t
+{
+  std::vector<catalog_record_t> records;
+  size_t num_skipped = 0;       // Messages of a packed file that are no trend, time signal or classification
+  std::string message;          // Why the input or one of its messages failed, empty if none did
+};
+
+static void AddFailure(std::string &rMessages, const std::string &rMessage)
+{
+  if (!rMessages.empty())
+  {
+    rMessages += "; ";
+  }
+  rMessages += rMessage;
+}
+
+// Adds the record of the message at Offset in the file to rInput. Messages of other kinds in a packed file are skipped.
+static void AddRecord(byte_span_t Message, Uint64_t Offset, catalog_kind8_t DefaultKind, bool Packed,
+                      catalog_input_t &rInput)
+{
+  input_kind_t input_kind = PeekInputKind(Message);
+  if (Packed && input_kind.envelope == envelope_transfer_message
+      && input_kind.transfer_message_field != transfer_message_trend
+      && input_kind.transfer_message_field != transfer_message_timesignal
+      && input_kind.transfer_message_field != transfer_message_classification_data)
+  {
+    ++rInput.num_skipped;
+    return;
+  }
+
+  catalog_record_t record;
+  std::string message;
+  if (!ReadCatalogRecord(Message, DefaultKind, record, message))
+  {
+    AddFailure(rInput.message, Packed ? "Message at offset " + std::to_string(Offset) + ": " + message : message);
+    return;
+  }
+  record.message_offset = Offset;
+  record.message_size = Message.size;
+  rInput.records.push_back(record);
+}
+
+static void ReadInput(const std::string &rFileName, bool Packed, input_file_t &rInputFile, catalog_input_t &rInput)
+{
+  if (!rInputFile.Open(rFileName.c_str(), rInput.message, false))
+  {
+    return;
+  }
+  catalog_kind8_t default_kind = CatalogKindFromExtension(rFileName.c_str());
+  if (!Packed)
+  {
+    rInputFile.size = ConvertHexToBinIfNeeded(rInputFile.size, (char*) rInputFile.p_data);
+    AddRecord(rInputFile.Span(), 0, default_kind, false, rInput);
+    rInputFile.Close();
+    return;
+  }
+
+  const Uint8_t *p_data = rInputFile.p_data;
+  const Uint8_t *p_end = p_data + rInputFile.size;
+  while (p_data < p_end)
+  {
+    Uint64_t length = 0;
+    if (!ReadWireVarint(p_data, p_end, length) || length > (Uint64_t) (p_end - p_data))
+    {
+      AddFailure(rInput.message, "Stream ends within the message at offset "
+                                 + std::to_string(p_data - rInputFile.p_data));
+      break;
+    }
+    AddRecord(byte_span_t { p_data, (size_t) length }, (Uint64_t) (p_data - rInputFile.p_data), default_kind, true,
+              rInput);
+    p_data += length;
+  }
+  rInputFile.Close();
+}
+
+static int PrintQueryUsage(const char *pProgram)
+{
+  fprintf(stderr, "Usage: %s --query <catalog file> [--config <uuid>] [--message <uuid>] [--kind <kind>] [--type <type>]\n"
+          "       %*s [--from <timestamp>] [--to <timestamp>] [--details]\n", pProgram, (int) strlen(pProgram) + 7, "");
+  return -1;
+}
+
+static void PrintRecord(const catalog_t &rCatalog, const catalog_record_t &rRecord, bool Details)
+{
+  std::string path = rCatalog.Path(rRecord);
+  if (Details)
+  {
+    fprintf(stdout, "%s\t%s\t%s\t%lld\t%lld\t%u\t%llu\t%u\t", CatalogKindAsString((catalog_kind8_t) rRecord.kind),
+            UuidAsString(rRecord.uuid_config).c_str(), UuidAsString(rRecord.uuid_message).c_str(),
+            rRecord.first_timestamp, rRecord.last_timestamp, rRecord.type, rRecord.sample_count, rRecord.compression);
+  }
+  if (rRecord.message_offset > 0)
+  {
+    fprintf(stdout, "%s\t%llu\t%llu\n", path.c_str(), rRecord.message_offset, rRecord.message_size);
+  }
+  else
+  {
+    fprintf(stdout, "%s\n", path.c_str());
+  }
+}
+
+// Runs --query, the output is meant for pipes, so the version line and the summary go to stderr
+static int RunQuery(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    return PrintQueryUsage(argv[0]);
+  }
+  catalog_query_t query;
+  bool details = false;
+  for (int i = 3; i < argc; ++i)
+  {
+    const char *p_value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(argv[i], "--details") == 0)
+    {
+      details = true;
+      continue;
+    }
+    if (p_value == NULL)
+    {
+      return PrintQueryUsage(argv[0]);
+    }
+    ++i;
+    if (strcmp(argv[i - 1], "--config") == 0 && UuidFromString(p_value, query.uuid_config))
+    {
+      query.has_uuid_config = true;
+    }
+    else if (strcmp(argv[i - 1], "--message") == 0 && UuidFromString(p_value, query.uuid_message))
+    {
+      query.has_uuid_message = true;
+    }
+    else if (strcmp(argv[i - 1], "--kind") == 0)
+    {
+      query.kind = strcmp(p_value, "trend") == 0 ? catalog_trend
+                   : strcmp(p_value, "timesignal") == 0 ? catalog_timesignal
+                   : strcmp(p_value, "classification") == 0 ? catalog_classification : (catalog_kind8_t) 0;
+      if (query.kind == 0)
+      {
+        return PrintQueryUsage(argv[0]);
+      }
+    }
+    else if (strcmp(argv[i - 1], "--type") == 0)
+    {
+      query.has_type = true;
+      query.type = (Uint32_t) strtoul(p_value, NULL, 10);
+    }
+    else if (strcmp(argv[i - 1], "--from") == 0)
+    {
+      query.from = strtoll(p_value, NULL, 10);
+    }
+    else if (strcmp(argv[i - 1], "--to") == 0)
+    {
+      query.to = strtoll(p_value, NULL, 10);
+    }
+    else
+    {
+      return PrintQueryUsage(argv[0]);
+    }
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  catalog_t catalog;
+  std::string message;
+  if (!catalog.Open(argv[2], message))
+  {
+    fprintf(stderr, "Error: Could not read %s: %s\n", argv[2], message.c_str());
+    return -1;
+  }
+  std::vector<const catalog_record_t*> found;
+  catalog.Query(query, [&](const catalog_record_t &rRecord)
+  {
+    found.push_back(&rRecord);
+  });
+  double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  for (const catalog_record_t *p_record : found)
+  {
+    PrintRecord(catalog, *p_record, details);
+  }
+  fflush(stdout);
+  fprintf(stderr, "Query summary: %zu of %llu messages in %.3f ms\n", found.size(), catalog.RecordCount(), milliseconds);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc >= 2 && strcmp(argv[1], "--query") == 0)
+  {
+    PrintVersionNumber(stderr);
+    return RunQuery(argc, argv);
+  }
+  PrintVersionNumber();
+
+  unsigned num_threads = DefaultNumThreads();
+  int first_input = 2;
+  if (argc >= first_input + 2 && strcmp(argv[first_input], "--jobs") == 0)
+  {
+    num_threads = (unsigned) atoi(argv[first_input + 1]);
+    first_input += 2;
+  }
+  bool packed = false;
+  if (argc > first_input && strcmp(argv[first_input], "--packed") == 0)
+  {
+    packed = true;
+    ++first_input;
+  }
+  if (argc <= first_input || num_threads == 0
+      || (strcmp(argv[first_input], "--list") == 0 && argc != first_input + 2))
+  {
+    fprintf(stderr, "Usage: %s <catalog file> [--jobs <threads>] [--packed] <input file | directory | pattern> ...\n",
+            argv[0]);
+    fprintf(stderr, "       %s <catalog file> [--jobs <threads>] [--packed] --list <file with input paths, - for stdin>\n",
+            argv[0]);
+    return -1;
+  }
+
+  std::vector<std::string> input_files;
+  if (!CollectBatchInputs(argc, argv, first_input, ".sctd .scts .sccd", input_files))
+  {
+    return -1;
+  }
+
+  std::vector<catalog_input_t> inputs(input_files.size());
+  std::vector<input_file_t> workers(num_threads);
+  RunWorkStealing(input_files.size(), num_threads, [&](unsigned Worker, size_t Index)
+  {
+    ReadInput(input_files[Index], packed, workers[Worker], inputs[Index]);
+  });
+
+  // Records in the order of the inputs, each path is stored once for all records of its file
+  std::vector<catalog_record_t> records;
+  std::string paths;
+  size_t num_failed = 0;
+  size_t num_skipped = 0;
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    const catalog_input_t &r_input = inputs[i];
+    if (!r_input.message.empty())
+    {
+      ++num_failed;
+      fprintf(stdout, "FAILED  %s: %s\n", input_files[i].c_str(), r_input.message.c_str());
+    }
+    num_skipped += r_input.num_skipped;
+    if (r_input.records.empty())
+    {
+      continue;
+    }
+    Uint64_t path_offset = paths.size();
+    paths += input_files[i];
+    for (catalog_record_t record : r_input.records)
+    {
+      record.path_offset = path_offset;
+      record.path_length = (Uint32_t) input_files[i].size();
+      records.push_back(record);
+    }
+  }
+
+  std::string message;
+  if (!WriteCatalog(argv[1], records, paths, message))
+  {
+    fprintf(stderr, "Error: Could not write %s: %s\n", argv[1], message.c_str());
+    return -1;
+  }
+  fprintf(stdout, "Catalog summary: %zu files, %zu messages, %zu skipped, %zu failed\n", input_files.size(),
+          records.size(), num_skipped, num_failed);
+  return num_failed == 0 ? 0 : -1;
+}
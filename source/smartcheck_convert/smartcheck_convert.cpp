@@ -0,0 +1,190 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Front end for all converters: tells the content of the input from its first bytes and runs the matching converter
+ with the same arguments.
+
+   smartcheck_convert [converter options] <input file> [<output file>]
+
+ A TransferMessage names its content in its first tag (device_config, timesignal, trend or classification_data), so
+ the input is not parsed here, only the converter parses it, once. Bare messages and raw binary data do not tell their
+ type, they are routed by the file extension (.scdc, .scts, .sctd, .sccd). The converters are expected next to
+ smartcheck_convert.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "../common/decoder.h"
+#include "../common/helper_functions.h"
+#include "../common/input_file.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+struct converter_t
+{
+  int transfer_message_field;
+  const char *p_extension;
+  const char *p_name;
+};
+
+static const converter_t converters[] =
+{
+  { transfer_message_device_config, ".scdc", "device_config_to_ascii" },
+  { transfer_message_timesignal, ".scts", "timesignal_data_to_ascii" },
+  { transfer_message_trend, ".sctd", "trend_data_to_ascii" },
+  { transfer_message_classification_data, ".sccd", "classification_data_to_ascii" }
+};
+
+static const size_t num_converters = sizeof(converters) / sizeof(converters[0]);
+
+// TransferMessage contents without a converter, for the error message
+static const char* TransferMessageContentName(int FieldNumber)
+{
+  switch (FieldNumber)
+  {
+    case 10:
+      return "system_state";
+    case 21:
+      return "job_config";
+    case 22:
+      return "characteristic_value_config";
+    case 23:
+      return "measurement_config";
+    case 100:
+      return "job_data";
+    case 102:
+      return "characteristic_value_data";
+    default:
+      return "unknown content";
+  }
+}
+
+static bool HasExtension(const char *pFileName, const char *pExtension)
+{
+  size_t length = strlen(pFileName);
+  size_t extension_length = strlen(pExtension);
+  return length >= extension_length && strcmp(pFileName + length - extension_length, pExtension) == 0;
+}
+
+static const converter_t* FindConverter(const char *pInputFile)
+{
+  input_file_t input;
+  ReadInputFile(pInputFile, input);
+  input.size = ConvertHexToBinIfNeeded(input.size, (char*) input.p_data);
+
+  input_kind_t kind = PeekInputKind(input.Span());
+  if (kind.envelope == envelope_transfer_message)
+  {
+    for (size_t i = 0; i < num_converters; ++i)
+    {
+      if (converters[i].transfer_message_field == kind.transfer_message_field)
+      {
+        return &converters[i];
+      }
+    }
+    fprintf(stderr, "Error: %s is a TransferMessage with %s (field %d), which no converter takes\n", pInputFile,
+            TransferMessageContentName(kind.transfer_message_field), kind.transfer_message_field);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < num_converters; ++i)
+  {
+    if (HasExtension(pInputFile, converters[i].p_extension))
+    {
+      return &converters[i];
+    }
+  }
+  fprintf(stderr, "Error: %s is no TransferMessage, bare messages and raw binary data need the extension .scdc, "
+          ".scts, .sctd or .sccd\n", pInputFile);
+  return NULL;
+}
+
+// Replaces this process by the converter, on Windows waits for it instead
+static int RunConverter(const char *pSelf, const converter_t &rConverter, char **argv)
+{
+  // The converters are installed next to this program
+  std::string path(pSelf);
+  size_t separator = path.find_last_of("/\\");
+  path = separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+  path += rConverter.p_name;
+  argv[0] = (char*) path.c_str();
+
+#ifdef _WIN32
+  path += ".exe";
+  argv[0] = (char*) path.c_str();
+  intptr_t result = _spawnv(_P_WAIT, path.c_str(), argv);
+  if (result != -1)
+  {
+    return (int) result;
+  }
+#else
+  // Without a directory the converter is searched in PATH like this program was
+  if (separator == std::string::npos)
+  {
+    execvp(path.c_str(), argv);
+  }
+  else
+  {
+    execv(path.c_str(), argv);
+  }
+#endif
+  fprintf(stderr, "Error: Could not run %s\n", path.c_str());
+  return -1;
+}
+
+int main(int argc, char **argv)
+{
+  // Options are passed on, the input is the first argument that is none
+  const char *p_input_file = NULL;
+  for (int i = 1; i < argc && p_input_file == NULL; ++i)
+  {
+    if (strcmp(argv[i], "--batch") == 0 || strcmp(argv[i], "--stream") == 0)
+    {
+      fprintf(stderr, "Error: %s converts single files, use the converter of the data type for %s\n", argv[0],
+              argv[i]);
+      return -1;
+    }
+    if (strncmp(argv[i], "--", 2) != 0)
+    {
+      p_input_file = argv[i];
+    }
+  }
+  if (p_input_file == NULL)
+  {
+    PrintVersionNumber();
+    fprintf(stderr, "Usage: %s [converter options] <input file> [output file]\n", argv[0]);
+    return -1;
+  }
+
+  // The converter could not read stdin again after it was peeked at here
+  if (strcmp(p_input_file, "-") == 0)
+  {
+    fprintf(stderr, "Error: %s needs an input file, use the converter of the data type for stdin\n", argv[0]);
+    return -1;
+  }
+
+  const converter_t *p_converter = FindConverter(p_input_file);
+  if (p_converter == NULL)
+  {
+    return -1;
+  }
+  return RunConverter(argv[0], *p_converter, argv);
+}
@@ -0,0 +1,316 @@
+// Copyright 2025 Schaeffler Monitoring Services GmbH
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files(the “Software”), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+ Keeps the trends of characteristic values in a trend store (see trend_store.h) instead of thousands of chunk files.
+
+   smartcheck_trend_store ingest <store directory> <input file | directory | pattern> ...
+   smartcheck_trend_store ingest <store directory> --list <file with input paths, - for stdin>
+   smartcheck_trend_store read <store directory> <uuid_characteristic_value_config> [--from <timestamp>]
+                          [--to <timestamp>] <output file, - for stdout>
+   smartcheck_trend_store list <store directory>
+
+ ingest takes the inputs like the batch mode of the converters and merges every .sctd chunk into the series of its
+ uuid_characteristic_value_config. The headers are read first, so that the chunks of a series are added in time order
+ and merged at once. Of entries with the same timestamp the one stored first is kept.
+ read writes the entries from..to (microseconds since 01.01.1970, both included) as raw trend binary data, which
+ trend_data_to_ascii converts to any of its formats. list prints the series of a store.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../common/batch.h"
+#include "../common/decoder.h"
+#include "../common/helper_functions.h"
+#include "../common/input_file.h"
+#include "../common/output_writer.h"
+#include "../common/trend_store.h"
+
+namespace fs = std::filesystem;
+
+struct chunk_t
+{
+  std::string file;
+  uuid_t uuid;                  // uuid_characteristic_value_config
+  timestamp_t first_timestamp;
+};
+
+static int PrintUsage(const char *pProgram)
+{
+  fprintf(stderr, "Usage: %s ingest <store directory> <input file | directory | pattern> ...\n", pProgram);
+  fprintf(stderr, "       %s ingest <store directory> --list <file with input paths, - for stdin>\n", pProgram);
+  fprintf(stderr, "       %s read <store directory> <uuid_characteristic_value_config> [--from <timestamp>]\n"
+          "       %*s [--to <timestamp>] <output file, - for stdout>\n", pProgram, (int) strlen(pProgram) + 5, "");
+  fprintf(stderr, "       %s list <store directory>\n", pProgram);
+  return -1;
+}
+
+// Opens a chunk and converts it from hex if needed. Returns false and sets rMessage on error.
+static bool OpenChunk(const std::string &rFile, bool ReadAhead, input_file_t &rInput, std::string &rMessage)
+{
+  if (!rInput.Open(rFile.c_str(), rMessage, ReadAhead))
+  {
+    return false;
+  }
+  rInput.size = ConvertHexToBinIfNeeded(rInput.size, (char*) rInput.p_data);
+  return true;
+}
+
+// Merges and saves the chunks added to the series and prints what they added. Returns false on error.
+static bool SaveSeries(trend_series_t &rSeries, Uint64_t &rAdded, Uint64_t &rDuplicates)
+{
+  std::string message;
+  if (!rSeries.Save(message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return false;
+  }
+  rAdded += rSeries.AddedEntries();
+  rDuplicates += rSeries.DuplicateEntries();
+  fprintf(stdout, "SAVED   %s: %llu entries added, %llu duplicates\n",
+          TrendSeriesName(rSeries.IndexHeader().header.uuid_characteristic_value_config).c_str(),
+          rSeries.AddedEntries(), rSeries.DuplicateEntries());
+  return true;
+}
+
+static int Ingest(int argc, char **argv)
+{
+  std::vector<std::string> input_files;
+  if (argc < 4 || !CollectBatchInputs(argc, argv, 3, ".sctd", input_files))
+  {
+    return argc < 4 ? PrintUsage(argv[0]) : -1;
+  }
+
+  // Headers first, then the chunks of each series in time order
+  input_file_t input;
+  std::string message;
+  std::vector<chunk_t> chunks;
+  size_t num_failed = 0;
+  for (const std::string &r_file : input_files)
+  {
+    trend_view_t trend;
+    decode_result_t result = decode_ok;
+    if (!OpenChunk(r_file, false, input, message)
+        || (result = DecodeTrendHeaderOnly(input.Span(), trend)) != decode_ok)
+    {
+      ++num_failed;
+      fprintf(stdout, "FAILED  %s: %s\n", r_file.c_str(), result != decode_ok ? DecodeResultAsString(result)
+                                                                             : message.c_str());
+      continue;
+    }
+    chunk_t chunk;
+    chunk.file = r_file;
+    memcpy(chunk.uuid, trend.header.uuid_characteristic_value_config, sizeof(uuid_t));
+    chunk.first_timestamp = trend.header.first_timestamp;
+    chunks.push_back(chunk);
+  }
+  input.Close();
+  std::stable_sort(chunks.begin(), chunks.end(), [](const chunk_t &rA, const chunk_t &rB)
+  {
+    int order = memcmp(rA.uuid, rB.uuid, sizeof(uuid_t));
+    return order < 0 || (order == 0 && rA.first_timestamp < rB.first_timestamp);
+  });
+
+  decode_buffer_t buffer;
+  trend_series_t series;
+  bool series_open = false;
+  size_t num_series = 0;
+  Uint64_t num_added = 0;
+  Uint64_t num_duplicates = 0;
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    const chunk_t &r_chunk = chunks[i];
+    if (i == 0 || memcmp(r_chunk.uuid, chunks[i - 1].uuid, sizeof(uuid_t)) != 0)
+    {
+      if (series_open && !SaveSeries(series, num_added, num_duplicates))
+      {
+        return -1;
+      }
+      series_open = series.Open(argv[2], r_chunk.uuid, message);
+      if (!series_open)
+      {
+        fprintf(stderr, "Error: %s\n", message.c_str());
+        return -1;
+      }
+      ++num_series;
+    }
+
+    trend_view_t trend;
+    decode_result_t result = decode_ok;
+    if (!OpenChunk(r_chunk.file, true, input, message)
+        || (result = DecodeTrend(input.Span(), buffer, trend)) != decode_ok)
+    {
+      ++num_failed;
+      fprintf(stdout, "FAILED  %s: %s\n", r_chunk.file.c_str(), result != decode_ok ? DecodeResultAsString(result)
+                                                                                   : message.c_str());
+      continue;
+    }
+    if (!series.Add(trend.header, trend.p_entries, (size_t) trend.header.value_count, message))
+    {
+      fprintf(stderr, "Error: %s\n", message.c_str());
+      return -1;
+    }
+    fprintf(stdout, "OK      %s -> %s: %d entries\n", r_chunk.file.c_str(), TrendSeriesName(r_chunk.uuid).c_str(),
+            trend.header.value_count);
+  }
+  input.Close();
+  if (series_open && !SaveSeries(series, num_added, num_duplicates))
+  {
+    return -1;
+  }
+
+  fprintf(stdout, "Ingest summary: %zu files, %zu series, %llu entries added, %llu duplicates, %zu failed\n",
+          input_files.size(), num_series, num_added, num_duplicates, num_failed);
+  return num_failed == 0 ? 0 : -1;
+}
+
+static int Read(int argc, char **argv)
+{
+  uuid_t uuid;
+  if (argc < 5 || !UuidFromString(argv[3], uuid))
+  {
+    return PrintUsage(argv[0]);
+  }
+  timestamp_t from = INT64_MIN;
+  timestamp_t to = INT64_MAX;
+  int i = 4;
+  for (; i + 2 < argc; i += 2)
+  {
+    if (strcmp(argv[i], "--from") == 0)
+    {
+      from = strtoll(argv[i + 1], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--to") == 0)
+    {
+      to = strtoll(argv[i + 1], NULL, 10);
+    }
+    else
+    {
+      return PrintUsage(argv[0]);
+    }
+  }
+  if (i != argc - 1)
+  {
+    return PrintUsage(argv[0]);
+  }
+
+  trend_series_t series;
+  std::string message;
+  std::vector<trend_entry_t> entries;
+  if (!series.Open(argv[2], uuid, message) || !series.Read(from, to, entries, message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return -1;
+  }
+  if (series.IndexHeader().entry_count == 0)
+  {
+    fprintf(stderr, "Error: No trend of %s in %s\n", argv[3], argv[2]);
+    return -1;
+  }
+  std::vector<Uint8_t> binary;
+  if (!MakeTrendBinary(series.IndexHeader().header, entries, binary, message))
+  {
+    fprintf(stderr, "Error: %s, use a shorter time range\n", message.c_str());
+    return -1;
+  }
+  char buffer[4096];
+  output_writer_t output(buffer, sizeof(buffer));
+  if (strcmp(argv[i], "-") == 0)
+  {
+    output.OpenStdout();
+  }
+  else if (!output.Open(argv[i], message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return -1;
+  }
+  output.Write(binary.data(), binary.size());
+  if (!output.Close(message))
+  {
+    fprintf(stderr, "Error: %s\n", message.c_str());
+    return -1;
+  }
+  fprintf(stderr, "%zu entries\n", entries.size());
+  return 0;
+}
+
+static int List(int argc, char **argv)
+{
+  if (argc != 3)
+  {
+    return PrintUsage(argv[0]);
+  }
+  std::vector<fs::path> index_files;
+  std::error_code error;
+  for (fs::directory_iterator it(argv[2], error), end; !error && it != end; it.increment(error))
+  {
+    if (it->path().extension() == ".tsi")
+    {
+      index_files.push_back(it->path());
+    }
+  }
+  if (error)
+  {
+    fprintf(stderr, "Error: Could not read %s\n", argv[2]);
+    return -1;
+  }
+  std::sort(index_files.begin(), index_files.end());
+
+  for (const fs::path &r_file : index_files)
+  {
+    uuid_t uuid;
+    trend_series_t series;
+    std::string message;
+    if (!UuidFromString(r_file.stem().string().c_str(), uuid) || !series.Open(argv[2], uuid, message))
+    {
+      fprintf(stdout, "FAILED  %s: %s\n", r_file.string().c_str(), message.c_str());
+      continue;
+    }
+    const std::vector<trend_store_block_t> &r_blocks = series.Blocks();
+    fprintf(stdout, "%s\t%llu entries\t%zu blocks", TrendSeriesName(uuid).c_str(), series.IndexHeader().entry_count,
+            r_blocks.size());
+    if (!r_blocks.empty())
+    {
+      fprintf(stdout, "\t%lld\t%lld", r_blocks.front().first_timestamp, r_blocks.back().last_timestamp);
+    }
+    fprintf(stdout, "\n");
+  }
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  const char *p_command = argc >= 3 ? argv[1] : "";
+  bool is_read = strcmp(p_command, "read") == 0;
+  // read may write the trend to stdout
+  PrintVersionNumber(is_read ? stderr : stdout);
+  if (strcmp(p_command, "ingest") == 0)
+  {
+    return Ingest(argc, argv);
+  }
+  if (is_read)
+  {
+    return Read(argc, argv);
+  }
+  if (strcmp(p_command, "list") == 0)
+  {
+    return List(argc, argv);
+  }
+  return PrintUsage(argv[0]);
+}
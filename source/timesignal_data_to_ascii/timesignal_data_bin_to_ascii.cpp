@@ -24,13 +24,19 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <zlib.h>
 #include <string.h>
+#include <string>
+#include <type_traits>
 #include <sys/stat.h>
+#include "../common/batch.h"
 #include "../common/datatypes.h"
+#include "../common/decoder.h"
 #include "../common/helper_functions.h"
-#include "TransferMessage.pb.h"
-#include "TimeSignal.pb.h"
+#include "../common/json_writer.h"
+#include "../common/message_stream.h"
+#include "../common/number_format.h"
+#include "../common/sample_export.h"
+#include "../common/sample_scaling.h"
 
 #ifdef _MSC_VER
 #include<winsock.h>
@@ -46,141 +52,37 @@
 #include <arpa/inet.h>
 #endif
 
-static FILE* outstream = stdout;
+static thread_local output_writer_t *outstream = NULL;
 
-const char* TimestampAsYYYYMMDDHHMMSSms(timestamp_t timestamp)
-{
-  static char buf[64];
-  int year = 0;
-  int month = 0;
-  int day = 0;
-  int hour = 0;
-  int minute = 0;
-  int second = 0;
-  struct tm timeStruct;
-
-  if (timestamp <= 0)
-  {
-    sprintf(buf, "-");
-    return buf;
-  }
-
-  memset(&timeStruct, 0, sizeof(struct tm));
-  const time_t ts = timestamp / 1000000;
-  int ms = timestamp % 1000;
-  gmtime_r(&ts, &timeStruct);
-
-  year = timeStruct.tm_year + 1900;
-  month = timeStruct.tm_mon + 1;
-  day = timeStruct.tm_mday;
-  hour = timeStruct.tm_hour;
-  minute = timeStruct.tm_min;
-  second = timeStruct.tm_sec;
-
-  sprintf(buf, "%04d-%02d-%02d %02d:%02d:%02d.%03d (UTC)", year, month, day, hour, minute, second, ms);
-  return buf;
-}
+// Layout of the sample table
+static const bool print_index = true;
+static const char column_separator = '\t';
 
-Uint16_t CalcChecksum(const void *pData, size_t Length)
-{
-  Uint64_t int_length = Length / sizeof(Uint16_t);
-  const Uint16_t *p_int_data = (Uint16_t*) pData;
-
-  Uint16_t checksum = 0;
-  Uint32_t i = 0;
-  for (i = 0; i < int_length; ++i)
-  {
-    checksum ^= p_int_data[i];
-  }
-
-  if (0 != Length % sizeof(Uint16_t))
-  {
-    Uint16_t temp = 0;
-    memcpy(&temp, &p_int_data[int_length], Length % sizeof(Uint16_t));
-    checksum ^= temp;
-  }
+// Size of the blocks the samples are inflated and printed in
+static const size_t sample_block_size = 64 * 1024;
 
-  return (checksum);
-}
+// Samples scaled at a time, into a buffer on the stack
+static const size_t scaled_chunk_size = 1024;
 
-int UncompressData(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int windowBits)
+// Output format, chosen with --format=
+enum output_format_t
 {
-  z_stream stream;
-  int err = 0;
-
-  stream.next_in = (Bytef*) source;
-  stream.avail_in = (uInt) sourceLen;
-  /* Check for source > 64K on 16-bit machine: */
-  if ((uLong) stream.avail_in != sourceLen) return Z_BUF_ERROR;
-
-  stream.next_out = dest;
-  stream.avail_out = (uInt) *destLen;
-  if ((uLong) stream.avail_out != *destLen) return Z_BUF_ERROR;
-
-  stream.zalloc = (alloc_func) 0;
-  stream.zfree = (free_func) 0;
-
-  err = inflateInit2(&stream, windowBits);
-  if (err != Z_OK) return err;
-
-  err = inflate(&stream, Z_FINISH);
-  if (err != Z_STREAM_END)
-  {
-    (void) inflateEnd(&stream);
-    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) return Z_DATA_ERROR;
-    return err;
-  }
-  *destLen = stream.total_out;
-
-  err = inflateEnd(&stream);
-  return err;
-}
-
-void PrintTimeSignal(const char *pFileName, const std::string &rBinaryData)
+  output_text,
+  output_npy,   // NumPy array, the header goes to <output file>.json
+  output_wav,   // Mono WAVE file with 1 / delta_x as sample rate
+  output_jsonl  // JSON Lines, header object followed by one object per sample
+};
+static output_format_t output_format = output_text;
+
+// --raw exports the samples as stored instead of scaled to physical values
+static bool export_raw = false;
+
+// Prints the header information and the column titles of the sample table
+void PrintTimeSignalHeader(const timesignal_view_t &rTimesignal)
 {
-  int num_row_elements = 1;
-  char separator = '\t';
-  bool index = true;
-  timesignal_header_t header;
-  memcpy(&header, &(rBinaryData[0]), sizeof(timesignal_header_t));
-
-  Uint16_t header_checksum_header = 0;
-  Uint16_t header_checksum_data = 0;
-  if (4 == header.version)
-  {
-    header_checksum_header = header.checksum_header;
-    header_checksum_data = header.checksum_data;
-  }
-  else
-  {
-    timesignal_header_v3_t *p_v3_header = (timesignal_header_v3_t*) &header;
-    header_checksum_header = p_v3_header->checksum_header;
-    header_checksum_data = p_v3_header->checksum_data;
-  }
-
-  Uint16_t calculated_checksum_header = CalcChecksum(&header, header.header_size - 2);
-  if (calculated_checksum_header != header_checksum_header)
-  {
-    fprintf(stderr, "Error: Header checksum not matching in file %s\n", pFileName);
-    exit(-1);
-  }
-
-  if (rBinaryData.size() != (header.header_size + header.byte_count))
-  {
-    fprintf(stderr, "Error: Data size mismatch %zu <--> %llu in %s\n", rBinaryData.size(),
-            header.header_size + header.byte_count, pFileName);
-    exit(-1);
-  }
-
-  unsigned char *data = new unsigned char[(unsigned int) header.byte_count];
-  memcpy(data, &(rBinaryData[header.header_size]), (size_t) header.byte_count);
-
-  Uint16_t calculated_checksum_data = CalcChecksum(data, (size_t) header.byte_count);
-  if (calculated_checksum_data != header_checksum_data)
-  {
-    fprintf(stderr, "Error: Data checksum not matching in file %s\n", pFileName);
-    exit(-1);
-  }
+  const timesignal_header_t &header = rTimesignal.header;
+  Uint16_t header_checksum_header = rTimesignal.checksum_header;
+  Uint16_t header_checksum_data = rTimesignal.checksum_data;
 
   // print header information
   fprintf(outstream, "\nHeader version:              \t%d\n", header.version);
@@ -267,76 +169,49 @@ void PrintTimeSignal(const char *pFileName, const std::string &rBinaryData)
           header.unit[6], header.unit[7], header.unit[8], header.unit[9], header.unit[10], header.unit[11],
           header.unit[12], header.unit[13], header.unit[14], header.unit[15]);
 
-  std::string compression_str = "unknown";
-  if (header.compression == no_compression)
-  {
-    compression_str = "no compression";
-  }
-  else if (header.compression == zlib)
-  {
-    compression_str = "zlib";
-  }
-  else if (header.compression == int24)
-  {
-    compression_str = "int24";
-  }
-  else if (header.compression == gzip)
-  {
-    compression_str = "gzip";
-  }
-  fprintf(outstream, "Compression:                 \t%s (%d)\n", compression_str.c_str(), header.compression);
+  fprintf(outstream, "Compression:                 \t%s (%d)\n", CompressionAsString(header.compression),
+          header.compression);
 
   std::string sample_type_str = "unknown";
-  int numBytes;
   if (header.sample_type == data_int8_t)
   {
     sample_type_str = "signed int 8";
-    numBytes = sizeof(Int8_t);
   }
   else if (header.sample_type == data_int16_t)
   {
     sample_type_str = "signed int 16";
-    numBytes = sizeof(Int16_t);
   }
   else if (header.sample_type == data_int32_t)
   {
     sample_type_str = "signed int 32";
-    numBytes = sizeof(Int32_t);
   }
   else if (header.sample_type == data_int64_t)
   {
     sample_type_str = "signed int 64";
-    numBytes = sizeof(Int64_t);
   }
   else if (header.sample_type == data_uint8_t)
   {
     sample_type_str = "unsigned signed int 8";
-    numBytes = sizeof(Uint8_t);
   }
   else if (header.sample_type == data_uint16_t)
   {
     sample_type_str = "unsigned signed int 16";
-    numBytes = sizeof(Uint16_t);
   }
   else if (header.sample_type == data_uint32_t)
   {
     sample_type_str = "unsignned int 32";
-    numBytes = sizeof(Uint32_t);
   }
   else if (header.sample_type == data_uint64_t)
   {
     sample_type_str = "unsigned int 64";
-    numBytes = sizeof(Uint64_t);
   }
   else if (header.sample_type == data_float32_t)
   {
     sample_type_str = "float 32";
-    numBytes = sizeof(Float32_t);
   }
   else if (header.sample_type == data_float64_t)
   {
     sample_type_str = "float 64";
-    numBytes = sizeof(Float64_t);
   }
   fprintf(outstream, "Data type:                   \t%s (%d)\n", sample_type_str.c_str(), header.sample_type);
   fprintf(outstream, "Number of samples:           \t%lld\n", header.sample_count);
@@ -345,351 +220,508 @@ void PrintTimeSignal(const char *pFileName, const std::string &rBinaryData)
   fprintf(outstream, "Data checksum:               \t%d\n", header_checksum_data);
   fprintf(outstream, "Header checksum:             \t%d\n", header_checksum_header);
 
-  unsigned char *uncompressed_data = NULL;
-  unsigned char *pt_data = NULL;
-
-  if (header.compression != no_compression)
+  if (print_index)
   {
-    size_t array_size = (size_t) header.sample_count;
-    uncompressed_data = (unsigned char*) malloc(array_size * numBytes);
-    unsigned long length = (int) header.sample_count * numBytes;
-    if (UncompressData(uncompressed_data, &length, (unsigned char*) data, (int) header.byte_count,
-                       header.compression == zlib ? 15 : 31) != Z_OK)
-    {
-      free(uncompressed_data);
-      fprintf(stderr, "Error: Could not uncompress data from file %s\n", pFileName);
-      exit(-1);
+    fprintf(outstream, "\n \tindex   \traw value \tscaled value\n\n");
+  }
+}
 
-    }
-    if (length != array_size * numBytes)
-    {
-      free(uncompressed_data);
-      fprintf(stderr, "Error: Uncompressed length does not match expected length in file %s\n", pFileName);
-      exit(-1);
+// Raw value column of the sample rows, in the format each sample type always had
+static inline char* FormatRawSample(char *p, Int8_t Value)
+{
+  return FormatInt(AppendLiteral(p, "      \t"), Value, 4);
+}
 
-    }
-    pt_data = uncompressed_data;
-  }
-  else
-  {
-    pt_data = data;
-  }
-  //
-  // size and data types from timesignals may differ, so we have different handling
-  //
+static inline char* FormatRawSample(char *p, Int16_t Value)
+{
+  return FormatInt(AppendLiteral(p, " \t"), Value, 11);
+}
 
-  char s = separator ? '\t' : ' ';
+static inline char* FormatRawSample(char *p, Int32_t Value)
+{
+  return FormatInt(AppendLiteral(p, " \t"), Value, 11);
+}
 
-  if (index == true)
-  {
-    fprintf(outstream, "\n \tindex   \traw value \tscaled value\n\n");
-  }
+static inline char* FormatRawSample(char *p, Int64_t Value)
+{
+  return FormatInt(AppendLiteral(p, " \t"), Value);
+}
 
-  if (header.sample_type == data_int8_t)
-  {
-    Int8_t *values = (Int8_t*) pt_data;
+static inline char* FormatRawSample(char *p, Uint8_t Value)
+{
+  return FormatUint(AppendLiteral(p, " \t"), Value, 11);
+}
 
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+static inline char* FormatRawSample(char *p, Uint16_t Value)
+{
+  return FormatUint(AppendLiteral(p, " \t"), Value, 11);
+}
 
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+static inline char* FormatRawSample(char *p, Uint32_t Value)
+{
+  return FormatUint(AppendLiteral(p, " \t"), Value, 11);
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, "      \t%4d%c  %lf", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
+static inline char* FormatRawSample(char *p, Uint64_t Value)
+{
+  return FormatUint(AppendLiteral(p, " \t"), Value);
+}
 
-  }
-  else if (header.sample_type == data_int16_t)
-  {
-    Int16_t *values = (Int16_t*) pt_data;
+static inline char* FormatRawSample(char *p, Float32_t Value)
+{
+  return FormatFixed(AppendLiteral(p, " \t"), Value);
+}
 
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+static inline char* FormatRawSample(char *p, Float64_t Value)
+{
+  return FormatFixed(AppendLiteral(p, " \t"), Value);
+}
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+// Prints SampleCount samples starting with sample number FirstSample, called once per inflated block
+template<typename sample_t>
+static void PrintSamples(const timesignal_header_t &rHeader, const sample_t *pSamples, size_t FirstSample,
+                         size_t SampleCount)
+{
+  // The int8 rows never had the blank behind the scaled value
+  const bool trailing_blank = !std::is_same<sample_t, Int8_t>::value;
+  const char separator = column_separator ? '\t' : ' ';
+  const size_t max_row_length = 4 * max_number_length;
+  Float64_t scaled[scaled_chunk_size];
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%11d%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
-  }
-  else if (header.sample_type == data_int32_t)
+  for (size_t first = 0; first < SampleCount; first += scaled_chunk_size)
   {
-    Int32_t *values = (Int32_t*) pt_data;
+    size_t count = SampleCount - first < scaled_chunk_size ? SampleCount - first : scaled_chunk_size;
+    ScaleSamples(pSamples + first, count, rHeader.offset, rHeader.scaling_factor, scaled);
 
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
+    for (size_t i = 0; i < count; i++)
     {
-      if (index == true)
+      char *p = outstream->Reserve(max_row_length);
+      if (print_index)
       {
-        fprintf(outstream, "   \t%4d ", i);
+        p = AppendLiteral(p, "   \t");
+        p = FormatInt(p, (long long) (FirstSample + first + i), 4);
+        *p++ = ' ';
       }
-
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
-
-      for (int j = 0; j < num_row_elements; j++)
+      p = FormatRawSample(p, pSamples[first + i]);
+      *p++ = separator;
+      p = AppendLiteral(p, "  ");
+      p = FormatFixed(p, scaled[i]);
+      if (trailing_blank)
       {
-        fprintf(outstream, " \t%11d%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
+        *p++ = ' ';
       }
-      if (index == true)
+      if (print_index)
       {
-        fprintf(outstream, "\n");
+        *p++ = '\n';
       }
+      outstream->Commit(p);
     }
   }
-  else if (header.sample_type == data_int64_t)
-  {
-    Int64_t *values = (Int64_t*) pt_data;
-
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
-
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%lld%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
+// Prints the end of the sample table
+void PrintTimeSignalEnd()
+{
+  if (print_index && !column_separator)
+  {
+    fprintf(outstream, "---------------------------------------------------------------------------------\n\n");
   }
-  else if (header.sample_type == data_uint8_t)
+  else
   {
-    Uint8_t *values = (Uint8_t*) pt_data;
-
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+    fprintf(outstream, "\n");
+  }
+}
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+// Streams and prints the samples of one sample type
+template<typename sample_t>
+static decode_result_t PrintTimeSignalSamples(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer)
+{
+  const Uint64_t table_start = outstream->BytesWritten();
+  const Uint64_t sample_count = (Uint64_t) rTimesignal.header.sample_count;
+  return StreamTimesignalSamples(rTimesignal, rBuffer, sample_block_size,
+                                 [&](const void *pSamples, size_t FirstSample, size_t SampleCount)
+                                 {
+                                   PrintSamples(rTimesignal.header, (const sample_t*) pSamples, FirstSample,
+                                                SampleCount);
+                                   // The rows of the first block tell how long the output gets
+                                   if (FirstSample == 0 && SampleCount < sample_count)
+                                   {
+                                     Uint64_t block_length = outstream->BytesWritten() - table_start;
+                                     outstream->Preallocate(block_length * (sample_count - SampleCount) / SampleCount);
+                                   }
+                                 });
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%11u%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
-  }
-  else if (header.sample_type == data_uint16_t)
-  {
-    Uint16_t *values = (Uint16_t*) pt_data;
+// Prints the time signal while its samples are inflated block by block, so output starts at once and the memory needed
+// does not depend on the length of the signal
+decode_result_t PrintTimeSignal(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer)
+{
+  PrintTimeSignalHeader(rTimesignal);
+  decode_result_t result = decode_error_sample_type;
+  DispatchSampleType(rTimesignal.header.sample_type, [&](auto SampleType)
+  {
+    result = PrintTimeSignalSamples<typename decltype(SampleType)::type>(rTimesignal, rBuffer);
+  });
+  PrintTimeSignalEnd();
+  return result;
+}
 
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+// Writes the header of the time signal as JSON next to the .npy file
+static bool WriteNpySidecar(const timesignal_view_t &rTimesignal, const char *pDescr, std::string &rMessage)
+{
+  const timesignal_header_t &header = rTimesignal.header;
+  char buffer[4096];
+  output_writer_t sidecar(buffer, sizeof(buffer));
+  if (!sidecar.Open((outstream->FileName() + ".json").c_str(), rMessage))
+  {
+    return false;
+  }
+
+  json_writer_t json(sidecar);
+  json.BeginLine();
+  json.Int("header_version", header.version);
+  json.Int("signal_type", header.signal_type);
+  json.Uuid("config_uuid", json_uuid_t(header.uuid_config));
+  json.Uuid("measurement_uuid", json_uuid_t(header.uuid_measurement));
+  json.Double("delta_x", header.delta_x);
+  json.Double("scaling_factor", header.scaling_factor);
+  json.Double("offset", header.offset);
+  json.Int("timestamp_microseconds", header.timestamp_microseconds);
+  json.Int("timestamp_first_sample_microseconds", header.timestamp_first_sample_microseconds);
+  json.Uuid("unit_uuid", json_uuid_t(header.unit));
+  json.Int("compression", header.compression);
+  json.Int("sample_type", header.sample_type);
+  json.Uint("sample_count", header.sample_count);
+  json.Float("rotational_frequency", header.rotational_frequency);
+  json.Float("order_domain_filter_delay_revolutions", header.order_domain_filter_delay_revolutions);
+  json.String("values", export_raw ? "raw" : "scaled");
+  json.String("dtype", pDescr);
+  json.EndLine();
+  return sidecar.Close(rMessage);
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%11u%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
+// Streams the samples into the .npy or WAVE file: raw straight from the inflate buffer, or scaled to scaled_t
+template<typename sample_t, typename scaled_t>
+static decode_result_t ExportSamples(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer)
+{
+  const timesignal_header_t &header = rTimesignal.header;
+  outstream->Preallocate(header.sample_count * (export_raw ? sizeof(sample_t) : sizeof(scaled_t)));
+  return StreamTimesignalSamples(rTimesignal, rBuffer, sample_block_size,
+                                 [&](const void *pSamples, size_t, size_t SampleCount)
+                                 {
+                                   if (export_raw)
+                                   {
+                                     outstream->Write(pSamples, SampleCount * sizeof(sample_t));
+                                     return;
+                                   }
+                                   const sample_t *p_samples = (const sample_t*) pSamples;
+                                   scaled_t scaled[scaled_chunk_size];
+                                   for (size_t first = 0; first < SampleCount; first += scaled_chunk_size)
+                                   {
+                                     size_t count = SampleCount - first < scaled_chunk_size ? SampleCount - first
+                                                                                            : scaled_chunk_size;
+                                     ScaleSamples(p_samples + first, count, header.offset, header.scaling_factor,
+                                                  scaled);
+                                     outstream->Write(scaled, count * sizeof(scaled_t));
+                                   }
+                                 });
+}
 
+// Raw value of a sample as JSON number
+template<typename sample_t>
+static inline void JsonRawSample(json_writer_t &rJson, sample_t Value)
+{
+  if (std::is_same<sample_t, Float32_t>::value)
+  {
+    rJson.Float("raw", (Float32_t) Value);
   }
-  else if (header.sample_type == data_uint32_t)
+  else if (std::is_floating_point<sample_t>::value)
   {
-    Uint32_t *values = (Uint32_t*) pt_data;
+    rJson.Double("raw", (Float64_t) Value);
+  }
+  else if (std::is_signed<sample_t>::value)
+  {
+    rJson.Int("raw", (Int64_t) Value);
+  }
+  else
+  {
+    rJson.Uint("raw", (Uint64_t) Value);
+  }
+}
 
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+// Streams the samples as one line each with the measurement uuid, the raw and the scaled value
+template<typename sample_t>
+static decode_result_t WriteJsonlSamples(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer,
+                                         json_writer_t &rJson, const json_uuid_t &rMeasurementUuid)
+{
+  const timesignal_header_t &header = rTimesignal.header;
+  const Uint64_t samples_start = outstream->BytesWritten();
+  const Uint64_t sample_count = (Uint64_t) header.sample_count;
+  return StreamTimesignalSamples(rTimesignal, rBuffer, sample_block_size,
+                                 [&](const void *pSamples, size_t FirstSample, size_t SampleCount)
+                                 {
+                                   const sample_t *p_samples = (const sample_t*) pSamples;
+                                   Float64_t scaled[scaled_chunk_size];
+                                   for (size_t first = 0; first < SampleCount; first += scaled_chunk_size)
+                                   {
+                                     size_t count = SampleCount - first < scaled_chunk_size ? SampleCount - first
+                                                                                            : scaled_chunk_size;
+                                     ScaleSamples(p_samples + first, count, header.offset, header.scaling_factor,
+                                                  scaled);
+                                     for (size_t i = 0; i < count; ++i)
+                                     {
+                                       rJson.BeginLine();
+                                       rJson.String("record", "sample");
+                                       rJson.Uuid("measurement_uuid", rMeasurementUuid);
+                                       rJson.Uint("index", FirstSample + first + i);
+                                       JsonRawSample(rJson, p_samples[first + i]);
+                                       rJson.Double("value", scaled[i]);
+                                       rJson.EndLine();
+                                     }
+                                   }
+                                   // The lines of the first block tell how long the output gets
+                                   if (FirstSample == 0 && SampleCount < sample_count)
+                                   {
+                                     Uint64_t block_length = outstream->BytesWritten() - samples_start;
+                                     outstream->Preallocate(block_length * (sample_count - SampleCount) / SampleCount);
+                                   }
+                                 });
+}
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+// Writes the header as first line and one line per sample
+static decode_result_t WriteTimeSignalJsonl(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer)
+{
+  const timesignal_header_t &header = rTimesignal.header;
+  const json_uuid_t measurement_uuid(header.uuid_measurement);
+  json_writer_t json(*outstream);
+
+  json.BeginLine();
+  json.String("record", "timesignal_header");
+  json.Uuid("measurement_uuid", measurement_uuid);
+  json.Uuid("config_uuid", json_uuid_t(header.uuid_config));
+  json.Uuid("unit_uuid", json_uuid_t(header.unit));
+  json.Int("header_version", header.version);
+  json.Int("signal_type", header.signal_type);
+  json.Double("delta_x", header.delta_x);
+  json.Double("scaling_factor", header.scaling_factor);
+  json.Double("offset", header.offset);
+  json.Int("timestamp_microseconds", header.timestamp_microseconds);
+  json.Int("timestamp_first_sample_microseconds", header.timestamp_first_sample_microseconds);
+  json.Int("compression", header.compression);
+  json.Int("sample_type", header.sample_type);
+  json.Uint("sample_count", header.sample_count);
+  json.Uint("byte_count", header.byte_count);
+  json.Float("rotational_frequency", header.rotational_frequency);
+  json.Float("order_domain_filter_delay_revolutions", header.order_domain_filter_delay_revolutions);
+  json.Uint("data_checksum", rTimesignal.checksum_data);
+  json.Uint("header_checksum", rTimesignal.checksum_header);
+  json.EndLine();
+
+  decode_result_t result = decode_error_sample_type;
+  DispatchSampleType(header.sample_type, [&](auto SampleType)
+  {
+    result = WriteJsonlSamples<typename decltype(SampleType)::type>(rTimesignal, rBuffer, json, measurement_uuid);
+  });
+  return result;
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%11u%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
+// Writes the samples as .npy, WAVE or JSON Lines file instead of text. Returns false and sets rMessage on error.
+static bool ExportTimeSignal(const timesignal_view_t &rTimesignal, decode_buffer_t &rBuffer, std::string &rMessage)
+{
+  const timesignal_header_t &header = rTimesignal.header;
+  if (output_format == output_jsonl)
+  {
+    decode_result_t result = WriteTimeSignalJsonl(rTimesignal, rBuffer);
+    if (result != decode_ok)
+    {
+      rMessage = DecodeResultAsString(result);
+      return false;
     }
+    return true;
   }
-  else if (header.sample_type == data_uint64_t)
+  const char *p_descr = export_raw ? NpyDescr(header.sample_type) : "<f8";
+  if (output_format == output_wav)
   {
-    Uint64_t *values = (Uint64_t*) pt_data;
-
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
+    if ((header.signal_type != raw_time_signal && header.signal_type != demodulated_time_signal)
+        || !(header.delta_x > 0.0))
     {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
-
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
-
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%llu%c  %lf ", values[i + j], s,
-                (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
+      rMessage = "WAVE export needs a time signal";
+      return false;
+    }
+    // Scaled samples are stored as 32 bit float
+    wav_format_t format = wav_format_float;
+    Uint16_t bits_per_sample = 32;
+    if (export_raw && !WavFormatOfSampleType(header.sample_type, format, bits_per_sample))
+    {
+      rMessage = "Sample type can not be stored raw in a WAVE file";
+      return false;
+    }
+    Uint32_t sample_rate = (Uint32_t) ((1.0 / header.delta_x) + 0.5);
+    if (!WriteWavHeader(*outstream, format, bits_per_sample, sample_rate, header.sample_count, rMessage))
+    {
+      return false;
     }
   }
-  else if (header.sample_type == data_float32_t)
+  else
   {
-    Float32_t *values = (Float32_t*) pt_data;
-
-    for (int i = 0; i < header.sample_count; i += num_row_elements)
-    {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+    WriteNpyHeader(*outstream, p_descr, header.sample_count);
+  }
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+  decode_result_t result = decode_error_sample_type;
+  DispatchSampleType(header.sample_type, [&](auto SampleType)
+  {
+    typedef typename decltype(SampleType)::type sample_t;
+    result = output_format == output_wav ? ExportSamples<sample_t, Float32_t>(rTimesignal, rBuffer)
+                                         : ExportSamples<sample_t, Float64_t>(rTimesignal, rBuffer);
+  });
+  if (result != decode_ok)
+  {
+    rMessage = DecodeResultAsString(result);
+    return false;
+  }
+  // Only written once the samples are, so a failed conversion leaves no sidecar without .npy file behind
+  if (output_format == output_npy && outstream->IsFile())
+  {
+    return WriteNpySidecar(rTimesignal, p_descr, rMessage);
+  }
+  return true;
+}
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%lf%c  %lf ", values[i + j], s, (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
-    }
+// Convert function of the batch and stream mode, called from several threads
+static bool ConvertTimeSignal(byte_span_t Input, output_writer_t *pOutstream, std::string &rMessage)
+{
+  // Each thread keeps its own decode buffer
+  static thread_local decode_buffer_t thread_buffer;
+  timesignal_view_t thread_timesignal;
+  decode_result_t result = DecodeTimesignalHeader(Input, thread_timesignal);
+  outstream = pOutstream;
+  if (result == decode_ok && output_format != output_text)
+  {
+    return ExportTimeSignal(thread_timesignal, thread_buffer, rMessage);
   }
-  else if (header.sample_type == data_float64_t)
+  if (result == decode_ok)
+  {
+    result = PrintTimeSignal(thread_timesignal, thread_buffer);
+  }
+  if (result != decode_ok)
   {
-    Float64_t *values = (Float64_t*) pt_data;
+    rMessage = DecodeResultAsString(result);
+    return false;
+  }
+  return true;
+}
 
-    for (int i = 0; i < (int) header.sample_count; i += num_row_elements)
+int main(int argc, char **argv)
+{
+  decode_buffer_t decode_buffer;
+  timesignal_view_t timesignal;
+
+  const char *p_format = TakeOptionValue(argc, argv, "--format=");
+  export_raw = TakeOption(argc, argv, "--raw");
+  if (p_format != NULL)
+  {
+    if (strcmp(p_format, "npy") == 0)
     {
-      if (index == true)
-      {
-        fprintf(outstream, "   \t%4d ", i);
-      }
+      output_format = output_npy;
+    }
+    else if (strcmp(p_format, "wav") == 0)
+    {
+      output_format = output_wav;
+    }
+    else if (strcmp(p_format, "jsonl") == 0)
+    {
+      output_format = output_jsonl;
+    }
+    else if (strcmp(p_format, "text") != 0)
+    {
+      fprintf(stderr, "Error: Unknown output format %s, use text, npy, wav or jsonl\n", p_format);
+      exit(-1);
+    }
+  }
 
-      num_row_elements =
-          i + num_row_elements < (int) header.sample_count ? num_row_elements : (int) header.sample_count - i;
+  PrintVersionNumber(IsStreamMode(argc, argv) ? stderr : stdout);
 
-      for (int j = 0; j < num_row_elements; j++)
-      {
-        fprintf(outstream, " \t%lf%c  %lf ", values[i + j], s, (values[i + j] - header.offset) * header.scaling_factor);
-      }
-      if (index == true)
-      {
-        fprintf(outstream, "\n");
-      }
+  if (IsStreamMode(argc, argv))
+  {
+    if (output_format != output_text && output_format != output_jsonl)
+    {
+      fprintf(stderr, "Error: --stream writes text or jsonl\n");
+      exit(-1);
     }
+    return RunStream(argc, argv, transfer_message_timesignal, ConvertTimeSignal, FindTimesignalPackage);
   }
-  if (index == true && !separator)
+
+  if (IsBatchMode(argc, argv))
   {
-    fprintf(outstream, "---------------------------------------------------------------------------------\n\n");
+    const char *p_output_extension = output_format == output_npy ? ".npy"
+                                     : output_format == output_wav ? ".wav"
+                                     : output_format == output_jsonl ? ".jsonl" : ".txt";
+    return RunBatch(argc, argv, ".scts", ConvertTimeSignal, p_output_extension, FindTimesignalPackage);
   }
-  else
+
+  static char output_buffer[default_output_buffer_size];
+  output_writer_t output(output_buffer, sizeof(output_buffer));
+  CheckCommandLineParameters(argc, argv, "timesignal data", output);
+  if (output_format != output_text && argc != 3)
   {
-    fprintf(outstream, "\n");
+    fprintf(stderr, "Error: %s: --format=%s needs an output file\n", argv[0], p_format);
+    exit(-1);
   }
+  outstream = &output;
 
-  free(data);
-  free(uncompressed_data);
-}
-
-#ifndef O_BINARY
-#define O_BINARY 0
-#endif
-
-int main(int argc, char **argv)
-{
-  PrintVersionNumber();
-    
-  int buffer_length = CheckCommandLineParameters(argc, argv, "timesignal data", outstream);
-
-  char* buffer = ReadInputFileIntoBuffer(argv[1], buffer_length);
+  input_file_t input;
+  ReadInputFile(argv[1], input);
 
-  ConvertHexToBinIfNeeded(buffer_length, buffer);
+  input.size = ConvertHexToBinIfNeeded(input.size, (char*) input.p_data);
 
-  smartcheck::TransferMessage transfer_message;
+  package_t package;
+  if (FindTimesignalPackage(input.Span(), package) && package.number_of_packages > 1)
+  {
+    fprintf(stderr, "Error: %s is package %d of %d of a split time signal, convert all packages together with --batch "
+            "<output directory> --reassemble\n", argv[1], package.package_number, package.number_of_packages);
+    exit(-1);
+  }
 
-  std::string binary_data = "";
-  if (transfer_message.ParseFromArray(buffer, (int) buffer_length) && transfer_message.IsInitialized() && transfer_message.has_timesignal())
+  decode_result_t result = DecodeTimesignalHeader(input.Span(), timesignal);
+  if (timesignal.envelope == envelope_transfer_message)
   {
     fprintf(stderr, "Timesignal is in ProtoBuf TransferMessage format\n");
-    binary_data = transfer_message.timesignal().binary_data();
+  }
+  else if (timesignal.envelope == envelope_protobuf)
+  {
+    fprintf(stderr, "Timesignal is in ProtoBuf format\n");
   }
   else
   {
-    smartcheck::TimeSignal timesignal_data;
-    if (timesignal_data.ParseFromArray(buffer, (int) buffer_length) && timesignal_data.IsInitialized()
-        && !timesignal_data.job_data_uuid().empty())
-    {
-      fprintf(stderr, "Timesignal is in ProtoBuf format\n");
-      binary_data = timesignal_data.binary_data();
-    }
-    else
+    fprintf(stderr, "Timesignal is in binary format\n");
+  }
+  if (result != decode_ok)
+  {
+    fprintf(stderr, "Error: %s in file %s\n", DecodeResultAsString(result), argv[1]);
+    exit(-1);
+  }
+  if (output_format != output_text)
+  {
+    std::string message;
+    if (!ExportTimeSignal(timesignal, decode_buffer, message))
     {
-      fprintf(stderr, "Timesignal is in binary format\n");
-      binary_data = std::string(buffer, buffer_length);
+      fprintf(stderr, "Error: %s in file %s\n", message.c_str(), argv[1]);
+      exit(-1);
     }
   }
-  PrintTimeSignal(argv[1], binary_data);
-  free(buffer);
+  else if ((result = PrintTimeSignal(timesignal, decode_buffer)) != decode_ok)
+  {
+    output.Flush();
+    fprintf(stderr, "Error: %s in file %s\n", DecodeResultAsString(result), argv[1]);
+    exit(-1);
+  }
+  CloseOutput(output);
   if (argc == 3)
   {
-    fclose(outstream);
     fprintf(stdout, "%s: Success: Time signal data written to file %s\n", argv[0], argv[2]);
   }
 
@@ -24,15 +24,20 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <zlib.h>
 #include <string.h>
 #include <time.h>
 #include <sys/stat.h>
+#include <vector>
+#include "../common/arrow_writer.h"
+#include "../common/batch.h"
 #include "../common/datatypes.h"
+#include "../common/decoder.h"
 #include "../common/helper_functions.h"
-
-#include "TransferMessage.pb.h"
-#include "Trend.pb.h"
+#include "../common/json_writer.h"
+#include "../common/message_stream.h"
+#include "../common/number_format.h"
+#include "../common/parquet_writer.h"
+#include "../common/timestamp_format.h"
 
 #ifdef _MSC_VER
 #include<winsock.h>
@@ -48,64 +53,9 @@
 #include <arpa/inet.h>
 #endif
 
-Uint16_t CalcChecksum(const void *pData, size_t Length)
-{
-  Uint64_t int_length = Length / sizeof(Uint16_t);
-  const Uint16_t *p_int_data = (Uint16_t*) pData;
-
-  Uint16_t checksum = 0;
-  Uint32_t i = 0;
-  for (i = 0; i < int_length; ++i)
-  {
-    checksum ^= p_int_data[i];
-  }
-
-  if (0 != Length % sizeof(Uint16_t))
-  {
-    Uint16_t temp = 0;
-    memcpy(&temp, &p_int_data[int_length], Length % sizeof(Uint16_t));
-    checksum ^= temp;
-  }
-
-  return (checksum);
-}
-
-const char* TimestampAsYYYYMMDDHHMMSSms(timestamp_t timestamp)
-{
-  static char buf[64];
-  int year = 0;
-  int month = 0;
-  int day = 0;
-  int hour = 0;
-  int minute = 0;
-  int second = 0;
-  struct tm timeStruct;
-
-  if (!timestamp)
-  {
-    sprintf(buf, "-");
-    return buf;
-  }
-
-  memset(&timeStruct, 0, sizeof(struct tm));
-  const time_t ts = timestamp / 1000000;
-  int ms = timestamp % 1000;
-  gmtime_r(&ts, &timeStruct);
-
-  year = timeStruct.tm_year + 1900;
-  month = timeStruct.tm_mon + 1;
-  day = timeStruct.tm_mday;
-  hour = timeStruct.tm_hour;
-  minute = timeStruct.tm_min;
-  second = timeStruct.tm_sec;
-
-  sprintf(buf, "%04d-%02d-%02d %02d:%02d:%02d.%03d (UTC)", year, month, day, hour, minute, second, ms);
-  return buf;
-}
-
 char* LongFloatToString(const char *pFormat, char Delimiter, Float64_t FloatValue)
 {
-  static char buffer[64];
+  static thread_local char buffer[64];
   snprintf(buffer, sizeof(buffer), pFormat, FloatValue);
   if (!strncmp(buffer, "nan", 3))
   {
@@ -115,130 +65,67 @@ char* LongFloatToString(const char *pFormat, char Delimiter, Float64_t FloatValu
   return buffer;
 }
 
-int UncompressData(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int windowBits)
+// "%f" like LongFloatToString("%f", ' ', Speed), for the trend entry lines
+static char* FormatSpeed(char *pOut, Float64_t Speed)
 {
-  z_stream stream;
-  int err = 0;
-  stream.next_in = (Bytef*) source;
-  stream.avail_in = (uInt) sourceLen;
-  /* Check for source > 64K on A16-bit machine: */
-
-  if ((uLong) stream.avail_in != sourceLen) return Z_BUF_ERROR;
-  stream.next_out = dest;
-  stream.avail_out = (uInt) *destLen;
-
-  if ((uLong) stream.avail_out != *destLen) return Z_BUF_ERROR;
-
-  stream.zalloc = (alloc_func) 0;
-  stream.zfree = (free_func) 0;
-
-  err = inflateInit2(&stream, windowBits);
-  if (err != Z_OK) return err;
-
-  err = inflate(&stream, Z_FINISH);
-  if (err != Z_STREAM_END)
+  char *p_end = FormatFixed(pOut, Speed);
+  if (!strncmp(pOut, "nan", 3))
   {
-
-    (void) inflateEnd(&stream);
-    if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) return Z_DATA_ERROR;
-    return err;
+    *pOut = ' ';
+    return pOut + 1;
   }
-  *destLen = stream.total_out;
-  err = inflateEnd(&stream);
-  return err;
+  return p_end;
 }
 
 #ifndef O_BINARY 
 #define O_BINARY 0
 #endif
 
-static FILE *outstream = stdout;
-
-int main(int argc, char **argv)
-{
-  PrintVersionNumber();
-
-  int buffer_length = CheckCommandLineParameters(argc, argv, "trend data", outstream);
-
-  char* buffer = ReadInputFileIntoBuffer(argv[1], buffer_length);
+static thread_local output_writer_t *outstream = NULL;
 
-  ConvertHexToBinIfNeeded(buffer_length, buffer);
+// Timestamp column of the trend entries, --raw-timestamps prints the microseconds since 01.01.1970
+static timestamp_style_t timestamp_style = timestamp_calendar;
 
-  std::string binary_data = "";
-
-  smartcheck::TransferMessage transfer_message;
-  if (transfer_message.ParseFromArray(buffer, (int) buffer_length) && transfer_message.IsInitialized()
-      && transfer_message.has_trend())
-  {
-    fprintf(stdout, "Trend is in transfer message protobuf format\n");
-    binary_data = transfer_message.trend().binary_data();
-  }
-  else
-  {
-    smartcheck::Trend trend_data;
-    if (trend_data.ParseFromArray(buffer, (int) buffer_length) && trend_data.IsInitialized() && !trend_data.trend_uuid().empty())
-    {
-      fprintf(stdout, "Trend is in protobuf format\n");
-      binary_data = trend_data.binary_data();
-    }
-    else
-    {
-      binary_data = std::string(buffer, buffer_length);
-    }
-  }
-  unsigned char *uncompressed_data = NULL;
-  unsigned char *pt_data = NULL;
-
-  trend_header_t header;
-  memcpy(&header, &(binary_data[0]), sizeof(trend_header_t));
-
-  Uint16_t calculated_checksum_header = CalcChecksum(&header, sizeof(trend_header_t) - 2);
-  if (calculated_checksum_header != header.checksum_header)
-  {
-    fprintf(stderr, "Error: Header checksum not matching in file %s\n", argv[1]);
-    exit(-1);
-  }
-
-  if (binary_data.size() != (header.header_size + header.byte_count))
-  {
-    fprintf(stderr, "Error: Data size mismatch %zu <--> %d in %s\n", binary_data.size(),
-            header.header_size + header.byte_count, argv[1]);
+// Output format, chosen with --format=
+enum output_format_t
+{
+  output_text,
+  output_arrow,          // Arrow IPC file
+  output_arrow_stream,   // Arrow IPC stream
+  output_parquet,
+  output_jsonl           // JSON Lines, header object followed by one object per entry
+};
 
-    exit(-1);
-  }
+static output_format_t output_format = output_text;
 
-  unsigned char *data = new unsigned char[header.byte_count];
-  memcpy(data, &(binary_data[header.header_size]), header.byte_count);
+// Rows per Arrow record batch and per Parquet row group. The entries of one batch or row group are transposed into
+// the columns below.
+static const size_t arrow_batch_rows = 65536;
+static const size_t parquet_row_group_rows = 131072;
 
-  Uint16_t calculated_checksum_data = CalcChecksum(data, header.byte_count);
-  if (calculated_checksum_data != header.checksum_data)
-  {
-    fprintf(stderr, "Error: Data checksum not matching in file %s\n", argv[1]);
-    exit(-1);
-  }
+struct trend_columns_t
+{
+  std::vector<Int64_t> timestamp;
+  std::vector<Float64_t> value;
+  std::vector<Float32_t> main_alarm_level;
+  std::vector<Float32_t> pre_alarm_level;
+  std::vector<Uint8_t> alarm_map_index;
+  std::vector<Uint8_t> alarm_status;
+  std::vector<Uint8_t> learning_mode_active;   // One byte per entry
+  std::vector<Uint8_t> learning_mode_bits;     // Bit packed for Arrow
+  std::vector<Float32_t> speed;
+};
+
+void PrintTrend(const trend_view_t &rTrend)
+{
+  const trend_header_t &header = rTrend.header;
 
   // print header information
   fprintf(outstream, "\nHeader version:             \t%d\n", header.version);
   fprintf(outstream, "Header size:                \t%d\n", header.header_size);
 
-  std::string compression_str = "unknown";
-  if (header.compression == no_compression)
-  {
-    compression_str = "no compression";
-  }
-  else if (header.compression == zlib)
-  {
-    compression_str = "zlib";
-  }
-  else if (header.compression == int24)
-  {
-    compression_str = "int24";
-  }
-  else if (header.compression == gzip)
-  {
-    compression_str = "gzip";
-  }
-  fprintf(outstream, "Compression:                \t%s (%d)\n", compression_str.c_str(), header.compression);
+  fprintf(outstream, "Compression:                \t%s (%d)\n", CompressionAsString(header.compression),
+          header.compression);
   fprintf(outstream,
           "Config-uuid:                \t%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X\n",
           header.uuid_characteristic_value_config[0], header.uuid_characteristic_value_config[1],
@@ -274,58 +161,323 @@ int main(int argc, char **argv)
   fprintf(outstream, "Data checksum:              \t%d\n", header.checksum_data);
   fprintf(outstream, "Header checksum:            \t%d\n", header.checksum_header);
 
-  if (header.compression != no_compression)
+  const trend_entry_t *values = rTrend.p_entries;
+  fprintf(
+      outstream,
+      "\n \t entry                       \ttimestamp        \t value      \tmain_alarm_level   \t pre_alarm_level  \talarm_map_index  \t alarm_status   \tlearning_mode  speed\n");
+//fprintf(outstream, "---------------------------------------------------------------------------------------------------------------------------------------------\n");
+  const size_t max_entry_length = 6 * max_number_length;
+  timestamp_formatter_t timestamp_formatter;
+  timestamp_formatter.style = timestamp_style;
+  for (int i = 0; i < header.value_count; i++)
+  {
+    char *p = AppendLiteral(outstream->Reserve(max_entry_length), "  \t");
+    p = FormatInt(p, i, 4);
+    p = AppendLiteral(p, "  \t");
+    p = timestamp_formatter.Format(p, values[i].timestamp);
+    p = AppendLiteral(p, "  \t");
+    p = FormatFixed(p, values[i].value, 6, 12);
+    p = AppendLiteral(p, "          \t");
+    p = FormatFixed(p, values[i].main_alarm_level, 6, 12);
+    p = AppendLiteral(p, "       \t");
+    p = FormatFixed(p, values[i].pre_alarm_level, 6, 12);
+    p = AppendLiteral(p, "                \t");
+    p = FormatInt(p, values[i].alarm_map_index);
+    p = AppendLiteral(p, "             \t");
+    p = FormatInt(p, values[i].alarm_status);
+    p = AppendLiteral(p, "               \t");
+    *p++ = values[i].learning_mode_active == true ? '1' : '0';
+    p = AppendLiteral(p, "   \t");
+    p = FormatSpeed(p, values[i].speed);
+    *p++ = '\n';
+    outstream->Commit(p);
+  }
+
+  fprintf(outstream, "\n");
+}
+
+static void AddTrendMetadata(key_value_metadata_t &rMetadata, const trend_header_t &rHeader)
+{
+  rMetadata.AddInt("header_version", rHeader.version);
+  rMetadata.AddInt("compression", rHeader.compression);
+  rMetadata.Add("config_uuid", UuidAsString(rHeader.uuid_characteristic_value_config));
+  rMetadata.Add("trend_uuid", UuidAsString(rHeader.uuid_trend));
+  rMetadata.AddInt("first_timestamp", rHeader.first_timestamp);
+  rMetadata.AddInt("last_timestamp", rHeader.last_timestamp);
+  rMetadata.Add("unit_uuid", UuidAsString(rHeader.unit));
+  rMetadata.AddFloat("lower_pre_alarm_level", rHeader.lower_pre_alarm_level, 9);
+  rMetadata.AddFloat("lower_main_alarm_level", rHeader.lower_main_alarm_level, 9);
+  rMetadata.AddInt("value_count", rHeader.value_count);
+}
+
+// Copies Count entries into the columns, one member after the other
+static void TransposeTrendEntries(const trend_entry_t *pEntries, size_t Count, trend_columns_t &rColumns)
+{
+  rColumns.timestamp.resize(Count);
+  rColumns.value.resize(Count);
+  rColumns.main_alarm_level.resize(Count);
+  rColumns.pre_alarm_level.resize(Count);
+  rColumns.alarm_map_index.resize(Count);
+  rColumns.alarm_status.resize(Count);
+  rColumns.learning_mode_active.resize(Count);
+  rColumns.speed.resize(Count);
+  for (size_t i = 0; i < Count; ++i)
+  {
+    rColumns.timestamp[i] = pEntries[i].timestamp;
+    rColumns.value[i] = pEntries[i].value;
+    rColumns.main_alarm_level[i] = pEntries[i].main_alarm_level;
+    rColumns.pre_alarm_level[i] = pEntries[i].pre_alarm_level;
+    rColumns.alarm_map_index[i] = pEntries[i].alarm_map_index;
+    rColumns.alarm_status[i] = pEntries[i].alarm_status;
+    rColumns.learning_mode_active[i] = pEntries[i].learning_mode_active ? 1 : 0;
+    rColumns.speed[i] = pEntries[i].speed;
+  }
+}
+
+// Writes the trend entries as Arrow table with one column per member of trend_entry_t, the header goes into the schema
+// metadata
+void WriteTrendArrow(const trend_view_t &rTrend)
+{
+  arrow_writer_t writer(*outstream, output_format == output_arrow_stream ? arrow_stream : arrow_file);
+  writer.AddField("timestamp", arrow_timestamp_us);
+  writer.AddField("value", arrow_float64);
+  writer.AddField("main_alarm_level", arrow_float32);
+  writer.AddField("pre_alarm_level", arrow_float32);
+  writer.AddField("alarm_map_index", arrow_uint8);
+  writer.AddField("alarm_status", arrow_uint8);
+  writer.AddField("learning_mode_active", arrow_bool);
+  writer.AddField("speed", arrow_float32);
+  AddTrendMetadata(writer.metadata, rTrend.header);
+  writer.WriteSchema();
+
+  static thread_local trend_columns_t columns;
+  const size_t value_count = rTrend.header.value_count > 0 ? (size_t) rTrend.header.value_count : 0;
+  for (size_t first = 0; first < value_count; first += arrow_batch_rows)
   {
-    size_t array_size = header.value_count;
-    uncompressed_data = (unsigned char*) malloc(array_size * sizeof(trend_entry_t));
-    unsigned long length = (unsigned long) array_size * (unsigned long) sizeof(trend_entry_t);
-    if (UncompressData(uncompressed_data, &length, (unsigned char*) data, header.byte_count,
-                       header.compression == zlib ? 15 : 31) != Z_OK)
+    const size_t count = value_count - first < arrow_batch_rows ? value_count - first : arrow_batch_rows;
+    TransposeTrendEntries(rTrend.p_entries + first, count, columns);
+    columns.learning_mode_bits.assign((count + 7) / 8, 0);
+    for (size_t i = 0; i < count; ++i)
     {
-      free(uncompressed_data);
-      fprintf(stderr, "Error: Could not uncompress data from file %s\n", argv[1]);
-      exit(-1);
+      columns.learning_mode_bits[i / 8] |= (Uint8_t) (columns.learning_mode_active[i] << (i % 8));
+    }
+    const void *const column_data[] = { columns.timestamp.data(), columns.value.data(),
+                                        columns.main_alarm_level.data(), columns.pre_alarm_level.data(),
+                                        columns.alarm_map_index.data(), columns.alarm_status.data(),
+                                        columns.learning_mode_bits.data(), columns.speed.data() };
+    writer.WriteRecordBatch((Int64_t) count, column_data);
+  }
+  writer.Finish();
+}
+
+// Writes the trend entries as Parquet file for archiving, with the columns and metadata of WriteTrendArrow. See
+// parquet_writer.h for the encodings.
+void WriteTrendParquet(const trend_view_t &rTrend)
+{
+  parquet_writer_t writer(*outstream);
+  writer.AddColumn("timestamp", parquet_timestamp_us);
+  writer.AddColumn("value", parquet_float64);
+  writer.AddColumn("main_alarm_level", parquet_float32);
+  writer.AddColumn("pre_alarm_level", parquet_float32);
+  writer.AddColumn("alarm_map_index", parquet_uint8);
+  writer.AddColumn("alarm_status", parquet_uint8);
+  writer.AddColumn("learning_mode_active", parquet_bool);
+  writer.AddColumn("speed", parquet_float32);
+  AddTrendMetadata(writer.metadata, rTrend.header);
+  writer.Start();
+
+  static thread_local trend_columns_t columns;
+  const size_t value_count = rTrend.header.value_count > 0 ? (size_t) rTrend.header.value_count : 0;
+  for (size_t first = 0; first < value_count; first += parquet_row_group_rows)
+  {
+    const size_t count = value_count - first < parquet_row_group_rows ? value_count - first : parquet_row_group_rows;
+    TransposeTrendEntries(rTrend.p_entries + first, count, columns);
+    const void *const column_data[] = { columns.timestamp.data(), columns.value.data(),
+                                        columns.main_alarm_level.data(), columns.pre_alarm_level.data(),
+                                        columns.alarm_map_index.data(), columns.alarm_status.data(),
+                                        columns.learning_mode_active.data(), columns.speed.data() };
+    writer.WriteRowGroup((Int64_t) count, column_data);
+  }
+  writer.Finish();
+}
+
+// Writes the header as first line and one line per trend entry, each with the trend uuid
+void WriteTrendJsonl(const trend_view_t &rTrend)
+{
+  const trend_header_t &header = rTrend.header;
+  const json_uuid_t trend_uuid(header.uuid_trend);
+  json_writer_t json(*outstream);
+
+  json.BeginLine();
+  json.String("record", "trend_header");
+  json.Uuid("trend_uuid", trend_uuid);
+  json.Uuid("config_uuid", json_uuid_t(header.uuid_characteristic_value_config));
+  json.Uuid("unit_uuid", json_uuid_t(header.unit));
+  json.Int("header_version", header.version);
+  json.Int("compression", header.compression);
+  json.Int("first_timestamp", header.first_timestamp);
+  json.Int("last_timestamp", header.last_timestamp);
+  json.Float("lower_pre_alarm_level", header.lower_pre_alarm_level);
+  json.Float("lower_main_alarm_level", header.lower_main_alarm_level);
+  json.Int("value_count", header.value_count);
+  json.EndLine();
+
+  const trend_entry_t *p_entries = rTrend.p_entries;
+  for (int i = 0; i < header.value_count; i++)
+  {
+    json.BeginLine();
+    json.String("record", "trend_entry");
+    json.Uuid("trend_uuid", trend_uuid);
+    json.Int("entry", i);
+    json.Int("timestamp", p_entries[i].timestamp);
+    json.Double("value", p_entries[i].value);
+    json.Float("main_alarm_level", p_entries[i].main_alarm_level);
+    json.Float("pre_alarm_level", p_entries[i].pre_alarm_level);
+    json.Uint("alarm_map_index", p_entries[i].alarm_map_index);
+    json.Uint("alarm_status", p_entries[i].alarm_status);
+    json.Bool("learning_mode_active", p_entries[i].learning_mode_active);
+    json.Float("speed", p_entries[i].speed);
+    json.EndLine();
+  }
+}
+
+// Prints the trend as text or writes it in the format chosen with --format=
+void OutputTrend(const trend_view_t &rTrend)
+{
+  if (output_format == output_text)
+  {
+    PrintTrend(rTrend);
+  }
+  else if (output_format == output_parquet)
+  {
+    WriteTrendParquet(rTrend);
+  }
+  else if (output_format == output_jsonl)
+  {
+    WriteTrendJsonl(rTrend);
+  }
+  else
+  {
+    WriteTrendArrow(rTrend);
+  }
+}
+
+// Convert function of the batch and stream mode, called from several threads
+static bool ConvertTrend(byte_span_t Input, output_writer_t *pOutstream, std::string &rMessage)
+{
+  // Each thread keeps its own decode buffer
+  static thread_local decode_buffer_t thread_buffer;
+  trend_view_t thread_trend;
+  decode_result_t result = DecodeTrend(Input, thread_buffer, thread_trend);
+  if (result != decode_ok)
+  {
+    rMessage = DecodeResultAsString(result);
+    return false;
+  }
+  outstream = pOutstream;
+  OutputTrend(thread_trend);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  decode_buffer_t decode_buffer;
+  trend_view_t trend;
 
+  if (TakeOption(argc, argv, "--raw-timestamps"))
+  {
+    timestamp_style = timestamp_raw_microseconds;
+  }
+  const char *p_format = TakeOptionValue(argc, argv, "--format=");
+  if (p_format != NULL)
+  {
+    if (strcmp(p_format, "arrow") == 0)
+    {
+      output_format = output_arrow;
+    }
+    else if (strcmp(p_format, "arrows") == 0)
+    {
+      output_format = output_arrow_stream;
+    }
+    else if (strcmp(p_format, "parquet") == 0)
+    {
+      output_format = output_parquet;
+    }
+    else if (strcmp(p_format, "jsonl") == 0)
+    {
+      output_format = output_jsonl;
     }
-    if (length != array_size * sizeof(trend_entry_t))
+    else if (strcmp(p_format, "text") != 0)
     {
-      free(uncompressed_data);
-      fprintf(stderr, "Error: Uncompressed length does not match expected length in file %s\n", argv[1]);
+      fprintf(stderr, "Error: Unknown output format %s, use text, arrow, arrows, parquet or jsonl\n", p_format);
       exit(-1);
+    }
+  }
+
+  PrintVersionNumber(IsStreamMode(argc, argv) ? stderr : stdout);
 
+  if (IsStreamMode(argc, argv))
+  {
+    if (output_format != output_text && output_format != output_jsonl)
+    {
+      fprintf(stderr, "Error: --stream writes text or jsonl\n");
+      exit(-1);
     }
-    pt_data = uncompressed_data;
-    // fprintf(outstream, "length sample array=%d:    \t (%d)\n", length);
+    return RunStream(argc, argv, transfer_message_trend, ConvertTrend, FindTrendPackage);
+  }
 
+  if (IsBatchMode(argc, argv))
+  {
+    const char *p_output_extension = output_format == output_arrow ? ".arrow"
+                                     : output_format == output_arrow_stream ? ".arrows"
+                                     : output_format == output_parquet ? ".parquet"
+                                     : output_format == output_jsonl ? ".jsonl" : ".txt";
+    return RunBatch(argc, argv, ".sctd", ConvertTrend, p_output_extension, FindTrendPackage);
   }
-  else
+
+  static char output_buffer[default_output_buffer_size];
+  output_writer_t output(output_buffer, sizeof(output_buffer));
+  CheckCommandLineParameters(argc, argv, "trend data", output);
+  if (output_format != output_text && argc != 3)
   {
-    pt_data = data;
+    fprintf(stderr, "Error: %s: --format=%s needs an output file\n", argv[0], p_format);
+    exit(-1);
   }
+  outstream = &output;
 
-  trend_entry_t *values = (trend_entry_t*) pt_data;
-  fprintf(
-      outstream,
-      "\n \t entry                       \ttimestamp        \t value      \tmain_alarm_level   \t pre_alarm_level  \talarm_map_index  \t alarm_status   \tlearning_mode  speed\n");
-//fprintf(outstream, "---------------------------------------------------------------------------------------------------------------------------------------------\n");
-  for (int i = 0; i < header.value_count; i++)
+  input_file_t input;
+  ReadInputFile(argv[1], input);
+
+  input.size = ConvertHexToBinIfNeeded(input.size, (char*) input.p_data);
+
+  package_t package;
+  if (FindTrendPackage(input.Span(), package) && package.number_of_packages > 1)
   {
-    fprintf(
-        outstream,
-        "  \t%4d  \t%s  \t%12.6lf          \t%12.6f       \t%12.6f                \t%d             \t%d               \t%s   \t%s\n",
-        i, TimestampAsYYYYMMDDHHMMSSms(values[i].timestamp), values[i].value, values[i].main_alarm_level,
-        values[i].pre_alarm_level, values[i].alarm_map_index, values[i].alarm_status,
-        values[i].learning_mode_active == true ? "1" : "0", LongFloatToString("%f", ' ', values[i].speed));
+    fprintf(stderr, "Error: %s is package %d of %d of a split trend, convert all packages together with --batch "
+            "<output directory> --reassemble\n", argv[1], package.package_number, package.number_of_packages);
+    exit(-1);
   }
 
-  fprintf(outstream, "\n");
+  decode_result_t result = DecodeTrend(input.Span(), decode_buffer, trend);
+  if (trend.envelope == envelope_transfer_message)
+  {
+    fprintf(stdout, "Trend is in transfer message protobuf format\n");
+  }
+  else if (trend.envelope == envelope_protobuf)
+  {
+    fprintf(stdout, "Trend is in protobuf format\n");
+  }
+  if (result != decode_ok)
+  {
+    fprintf(stderr, "Error: %s in file %s\n", DecodeResultAsString(result), argv[1]);
+    exit(-1);
+  }
+
+  OutputTrend(trend);
 
-  free(buffer);
-  free(data);
-  free(uncompressed_data);
+  CloseOutput(output);
   if (argc == 3)
   {
-    fclose(outstream);
     fprintf(stdout, "%s: Success: Trend data written to file %s\n", argv[0], argv[2]);
   }
 